@@ -0,0 +1,106 @@
+#include <fs.h>
+#include <ktesseract.h>
+#include <llvm/ADT/StringRef.h>
+#include <llvm/Support/FormatVariadic.h>
+#include <llvm/Support/raw_ostream.h>
+#include <optional>
+#include <resolution.h>
+#include <string>
+#include <util.h>
+#include <vector>
+
+/*
+
+Throughput gained against Accuracy lost by normalizeResolution().
+
+Every Image is recognized once at its original Resolution - that Text is the Reference. Each
+target x-height is then timed end to end (scaling included) and scored by Character Accuracy
+against the Reference: 1 - edit_distance / max(length). The Engine is initialized before any
+Timing, so TessBaseAPI::Init is not charged to the original Resolution.
+
+    ./resolution_benchmark [image_dir]
+
+*/
+
+namespace {
+    struct Sample {
+        std::string name;
+        PixPtr      pix;
+        std::string reference;
+    };
+
+    auto characterAccuracy(llvm::StringRef text, llvm::StringRef reference) -> double {
+        std::size_t length = std::max(text.size(), reference.size());
+        if (length == 0) {
+            return 1.0;
+        }
+        return 1.0 - static_cast<double>(text.edit_distance(reference)) / length;
+    }
+} // namespace
+
+auto main(int argc, char **argv) -> int {
+    std::string image_dir = argc > 1 ? argv[1] : IMAGE_FOLDER_PATH;
+
+    auto pathsOrErr = getFilePaths(image_dir);
+    if (!pathsOrErr) {
+        llvm::logAllUnhandledErrors(pathsOrErr.takeError(), llvm::errs(), "benchmark: ");
+        return 1;
+    }
+
+    TesseractPool pool(1);
+    pool.warm(1);
+
+    std::vector<Sample> samples;
+    double              baseline_ms = 0;
+
+    for (const auto &path: *pathsOrErr) {
+        PixPtr pix;
+        try {
+            pix = decodePix(readBytesFromFile(path));
+        } catch (const std::exception &) {
+            continue;
+        }
+
+        auto        start     = getStartTime();
+        std::string reference = getTextOCR(pool, pix.get());
+        baseline_ms += getDuration(start);
+
+        samples.push_back({path, std::move(pix), std::move(reference)});
+    }
+
+    if (samples.empty()) {
+        llvm::errs() << "No decodable Images in " << image_dir << '\n';
+        return 1;
+    }
+
+    llvm::outs() << llvm::formatv("{0,-10} {1,12} {2,10} {3,9} {4,10} {5,10}\n", "x-height",
+                                  "total ms", "img/s", "speedup", "scaled", "accuracy");
+    llvm::outs() << llvm::formatv("{0,-10} {1,12:F1} {2,10:F2} {3,9:F2} {4,10} {5,10:P}\n",
+                                  "original", baseline_ms, samples.size() * 1000.0 / baseline_ms,
+                                  1.0, 0, 1.0);
+
+    for (l_int32 x_height: {40, 32, 24, 20, 16, 12}) {
+        imgstr::ResolutionOptions options {.target_x_height = x_height};
+
+        double      total_ms = 0;
+        double      accuracy = 0;
+        std::size_t scaled   = 0;
+
+        for (const auto &sample: samples) {
+            auto start = getStartTime();
+
+            PixPtr      small = imgstr::normalizeResolution(sample.pix.get(), options);
+            std::string text  = getTextOCR(pool, small ? small.get() : sample.pix.get());
+
+            total_ms += getDuration(start);
+            accuracy += characterAccuracy(text, sample.reference);
+            scaled += small ? 1 : 0;
+        }
+
+        llvm::outs() << llvm::formatv("{0,-10} {1,12:F1} {2,10:F2} {3,9:F2} {4,10} {5,10:P}\n",
+                                      x_height, total_ms, samples.size() * 1000.0 / total_ms,
+                                      baseline_ms / total_ms, scaled, accuracy / samples.size());
+    }
+
+    return 0;
+}
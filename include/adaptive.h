@@ -0,0 +1,166 @@
+// adaptive.h
+#ifndef ADAPTIVE_H
+#define ADAPTIVE_H
+
+#include <cstddef>
+#include <ktesseract.h>
+#include <memory>
+#include <optional>
+#include <pix.h>
+#include <stdexcept>
+#include <string>
+#include <tesseract/resultiterator.h>
+#include <vector>
+
+namespace imgstr {
+
+#pragma region ADAPTIVE_OCR               /* Confidence driven two Pass Recognition */
+
+    /// @brief When the cheap first Pass is trusted - see getTextOCRAdaptive()
+    struct AdaptiveOptions {
+        OcrProfile first_pass    = OcrProfile::fast;
+        int        min_mean_conf = 80;    // MeanTextConf() below this - second Pass
+        int        min_word_conf = 60;    // Words below this count as low Confidence
+        float      max_low_words = 0.10F; // Fraction of low Confidence Words tolerated
+        bool       rerun_regions = true;  // re-read only the low Confidence Blocks
+    };
+
+    /// @brief Text of an adaptive Recognition and which Passes produced it
+    struct AdaptiveResult {
+        std::string text;
+        int         mean_conf     = 0; // of the first Pass
+        bool        second_pass   = false;
+        std::size_t regions_rerun = 0; // 0 with second_pass - the whole Image was re-read
+    };
+
+    namespace detail {
+        struct Block {
+            std::string text;
+            float       conf;
+            int         left, top, right, bottom;
+        };
+
+        /// @brief Text, Confidence and Bounds of every Block of the last Recognition
+        inline auto recognizedBlocks(tesseract::TessBaseAPI &engine) -> std::vector<Block> {
+            std::vector<Block>                         blocks;
+            std::unique_ptr<tesseract::ResultIterator> it(engine.GetIterator());
+
+            if (!it || it->Empty(tesseract::RIL_BLOCK)) {
+                return blocks;
+            }
+
+            do {
+                Block block {};
+                it->BoundingBox(
+                    tesseract::RIL_BLOCK, &block.left, &block.top, &block.right, &block.bottom);
+                block.conf = it->Confidence(tesseract::RIL_BLOCK);
+
+                std::unique_ptr<char[]> text(it->GetUTF8Text(tesseract::RIL_BLOCK));
+                if (text) {
+                    block.text = text.get();
+                }
+                blocks.push_back(std::move(block));
+            } while (it->Next(tesseract::RIL_BLOCK));
+
+            return blocks;
+        }
+
+        /// @brief Fraction of recognized Words below the Confidence Threshold
+        inline auto lowConfidenceWords(tesseract::TessBaseAPI &engine, int min_word_conf)
+            -> float {
+            std::unique_ptr<int[]> confidences(engine.AllWordConfidences());
+            if (!confidences) {
+                return 0.0F;
+            }
+
+            std::size_t words = 0, low = 0;
+            for (const int *conf = confidences.get(); *conf >= 0; ++conf) {
+                ++words;
+                low += *conf < min_word_conf ? 1 : 0;
+            }
+            return words == 0 ? 0.0F : static_cast<float>(low) / words;
+        }
+    } // namespace detail
+
+    /// @brief Recognize with the cheap Profile first and spend the heavy Profile only where the
+    /// first Pass is unsure. Clean Screenshots and Scans stop after the first Pass; otherwise
+    /// the low Confidence Blocks - or the whole Image if most Blocks are low - are read again
+    /// with Engines of the accurate Pool.
+    /// @param fast_pool - Engines of options.first_pass
+    /// @param accurate_pool - Engines of the requested Profile
+    /// @param image
+    /// @param img_mode
+    /// @param options
+    /// @param deadline - for both Passes together
+    /// @return AdaptiveResult
+    /// @throws OcrTimeoutError if the Deadline passes first
+    inline auto getTextOCRAdaptive(TesseractPool             &fast_pool,
+                                   TesseractPool             &accurate_pool,
+                                   Pix                       *image,
+                                   ImgMode                    img_mode,
+                                   const AdaptiveOptions     &options  = {},
+                                   std::optional<OcrDeadline> deadline = std::nullopt)
+        -> AdaptiveResult {
+        AdaptiveResult             result;
+        std::vector<detail::Block> blocks;
+        {
+            auto engine = fast_pool.acquire();
+
+            engine->SetPageSegMode(engineProfile(fast_pool.ocrProfile()).pageSegMode(img_mode));
+            engine->SetImage(image);
+
+            recognizeWithin(*engine, deadline);
+
+            result.mean_conf = engine->MeanTextConf();
+
+            if (result.mean_conf >= options.min_mean_conf &&
+                detail::lowConfidenceWords(*engine, options.min_word_conf) <=
+                    options.max_low_words) {
+                std::unique_ptr<char[]> rawText(engine->GetUTF8Text());
+                result.text = rawText ? std::string(rawText.get()) : std::string();
+                return result;
+            }
+
+            blocks = detail::recognizedBlocks(*engine);
+        }
+
+        result.second_pass = true;
+
+        std::size_t low_blocks = 0;
+        for (const auto &block: blocks) {
+            low_blocks += block.conf < options.min_mean_conf ? 1 : 0;
+        }
+
+        // low Words spread evenly over the Blocks, or mostly low Blocks - re-read everything
+        if (!options.rerun_regions || low_blocks == 0 || 2 * low_blocks > blocks.size()) {
+            result.text = getTextOCR(accurate_pool, image, img_mode, deadline);
+            return result;
+        }
+
+        auto engine = accurate_pool.acquire();
+        engine->SetPageSegMode(tesseract::PSM_SINGLE_BLOCK);
+        engine->SetImage(image);
+
+        for (auto &block: blocks) {
+            if (block.conf < options.min_mean_conf) {
+                engine->SetRectangle(
+                    block.left, block.top, block.right - block.left, block.bottom - block.top);
+                if (deadline) {
+                    recognizeWithin(*engine, deadline);
+                }
+
+                std::unique_ptr<char[]> rawText(engine->GetUTF8Text());
+                block.text = rawText ? std::string(rawText.get()) : std::string();
+                ++result.regions_rerun;
+            }
+            result.text += block.text;
+        }
+
+        return result;
+    }
+
+#pragma endregion
+
+} // namespace imgstr
+
+#endif // ADAPTIVE_H
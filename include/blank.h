@@ -0,0 +1,137 @@
+// blank.h
+#ifndef BLANK_H
+#define BLANK_H
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstdlib>
+#include <optional>
+#include <pix.h>
+
+namespace imgstr {
+
+#pragma region BLANK_DETECTION            /* Skip OCR for Pages without Text */
+
+    /// @brief Thresholds for isBlankImage(). Fractions are of the Cells of the downsampled Image.
+    /// Calibrated so a single short Line - a Page Number, a Caption, a Signature Line - on an A4
+    /// Scan at 300 DPI still counts as Text: skipping a Page loses its Text silently, reading a
+    /// blank one only costs a Tesseract Pass.
+    struct BlankOptions {
+        l_int32 sample_width     = 256;      // Images are measured at this Width
+        l_int32 contrast         = 64;       // Gray Levels between Ink and Background
+        float   min_ink_fraction = 0.00005F; // less Ink than this - blank Separator Page
+        float   min_edge_density = 0.001F;   // fewer Edges as well - confirms an inkless Page
+    };
+
+    /// @brief Pixel Statistics of a downsampled Image
+    struct InkStats {
+        float ink_fraction = 0; // Cells with a Pixel differing from the Background by the contrast
+        float edge_density = 0; // Pixels of the averaged Copy with a sharp Step to a Neighbour
+    };
+
+    /// @brief Measure Ink Coverage and Edge Density of the Image. Ink is counted on Cells of the
+    /// full-resolution Grayscale Image by their darkest and lightest Pixel, so a Stroke one Pixel
+    /// wide still marks its Cell. Edges are counted on an area-averaged Copy sample_width Pixels
+    /// wide, whose median Gray Value is the Background Level - dark Backgrounds measure the same
+    /// as light.
+    /// @param image
+    /// @param options
+    /// @return std::optional<InkStats> - std::nullopt if the Image could not be converted
+    inline auto measureInk(Pix *image, const BlankOptions &options = {})
+        -> std::optional<InkStats> {
+        PixPtr gray(pixConvertTo8(image, 0));
+        if (!gray || pixGetWidth(gray.get()) == 0 || pixGetHeight(gray.get()) == 0) {
+            return std::nullopt;
+        }
+
+        PixPtr small;
+        if (pixGetWidth(gray.get()) > options.sample_width) {
+            small.reset(pixScaleToSize(gray.get(), options.sample_width, 0));
+        }
+
+        l_int32 cell = std::max<l_int32>(
+            1, (pixGetWidth(gray.get()) + options.sample_width - 1) / options.sample_width);
+
+        PixPtr darkest(pixScaleGrayMinMax(gray.get(), cell, cell, L_CHOOSE_MIN));
+        PixPtr lightest(pixScaleGrayMinMax(gray.get(), cell, cell, L_CHOOSE_MAX));
+        if (!darkest || !lightest || (pixGetWidth(gray.get()) > options.sample_width && !small)) {
+            return std::nullopt;
+        }
+
+        auto level = [](Pix *pix, l_int32 x, l_int32 y) -> l_int32 {
+            l_uint32 value = 0;
+            pixGetPixel(pix, x, y, &value);
+            return static_cast<l_int32>(value & 0xFF);
+        };
+
+        Pix *averaged = small ? small.get() : gray.get();
+
+        l_int32 width  = pixGetWidth(averaged);
+        l_int32 height = pixGetHeight(averaged);
+        auto    total  = static_cast<uint64_t>(width) * static_cast<uint64_t>(height);
+
+        std::array<uint64_t, 256> histogram {};
+        for (l_int32 y = 0; y < height; ++y) {
+            for (l_int32 x = 0; x < width; ++x) {
+                ++histogram[level(averaged, x, y)];
+            }
+        }
+
+        l_int32  background = 0;
+        uint64_t seen       = histogram[0];
+        while (background < 255 && seen < total / 2) {
+            seen += histogram[++background];
+        }
+
+        auto sharp = [&options](l_int32 a, l_int32 b) {
+            return std::abs(a - b) > options.contrast;
+        };
+
+        uint64_t edges = 0;
+        for (l_int32 y = 0; y < height; ++y) {
+            for (l_int32 x = 0; x < width; ++x) {
+                l_int32 value = level(averaged, x, y);
+
+                bool step_right = x + 1 < width && sharp(value, level(averaged, x + 1, y));
+                bool step_below = y + 1 < height && sharp(value, level(averaged, x, y + 1));
+                if (step_right || step_below) {
+                    ++edges;
+                }
+            }
+        }
+
+        l_int32  cells_x = pixGetWidth(darkest.get());
+        l_int32  cells_y = pixGetHeight(darkest.get());
+        uint64_t ink     = 0;
+
+        for (l_int32 y = 0; y < cells_y; ++y) {
+            for (l_int32 x = 0; x < cells_x; ++x) {
+                if (sharp(level(darkest.get(), x, y), background) ||
+                    sharp(level(lightest.get(), x, y), background)) {
+                    ++ink;
+                }
+            }
+        }
+
+        auto cells = static_cast<uint64_t>(cells_x) * static_cast<uint64_t>(cells_y);
+        return InkStats {static_cast<float>(ink) / cells, static_cast<float>(edges) / total};
+    }
+
+    /// @brief Check ahead of OCR for blank Separator Pages - a few Passes over the Pixels, well
+    /// under the hundreds of Milliseconds of a Tesseract Pass. Only a Page without Ink is blank;
+    /// Edge Density has to agree but never skips a Page on its own, so Photos are still read.
+    /// @param image
+    /// @param options
+    /// @return bool - true if the Image should not be sent to OCR, false if it cannot be measured
+    inline auto isBlankImage(Pix *image, const BlankOptions &options = {}) -> bool {
+        auto stats = measureInk(image, options);
+        return stats && stats->ink_fraction < options.min_ink_fraction &&
+               stats->edge_density < options.min_edge_density;
+    }
+
+#pragma endregion
+
+} // namespace imgstr
+
+#endif // BLANK_H
@@ -0,0 +1,313 @@
+// cache.h
+#ifndef CACHE_H
+#define CACHE_H
+
+#include <atomic>
+#include <cstdint>
+#include <folly/concurrency/ConcurrentHashMap.h>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace imgstr {
+
+#pragma region CLOCK_CACHE                /* Bounded Concurrent Cache with CLOCK Eviction */
+
+    /// @brief Concurrent Cache bounded by both an Entry Count and a Byte Budget.
+    /// - Lookups are wait-free reads on a folly::ConcurrentHashMap and only flip a reference bit
+    /// - Inserts are serialized on the CLOCK ring and evict unreferenced Entries until the new
+    ///   Entry fits within both bounds
+    /// - Values are handed out as std::shared_ptr<const Value> so an evicted Entry stays valid for
+    ///   readers that still hold it
+    ///
+    /// @code{.cpp}
+    ///     ClockCache<std::string, Image> cache(1000, 64 << 20);
+    ///     auto img = cache.insert(sha, std::move(image), image.footprint());
+    ///     if (auto hit = cache.find(sha)) { ... }
+    /// @endcode
+    template <typename Key, typename Value, typename Hasher = std::hash<Key>>
+    class ClockCache {
+        struct Entry {
+            std::shared_ptr<const Value> value;
+            std::size_t                  bytes;
+            std::size_t                  slot = 0; // Position in the Ring
+            mutable std::atomic<bool>    referenced {true};
+
+            Entry(std::shared_ptr<const Value> value, std::size_t bytes)
+                : value(std::move(value)),
+                  bytes(bytes) {}
+        };
+
+        struct Slot {
+            Key                    key;
+            std::shared_ptr<Entry> entry;
+        };
+
+        folly::ConcurrentHashMap<Key, std::shared_ptr<Entry>, Hasher> map;
+
+        std::mutex               clock_mutex;
+        std::vector<Slot>        ring;
+        std::vector<std::size_t> free_slots;
+        std::size_t              hand = 0;
+
+        std::size_t              capacity;
+        std::size_t              byte_budget;
+        std::atomic<std::size_t> entries {0};
+        std::atomic<std::size_t> bytes_used {0};
+        std::atomic<uint64_t>    inserts {0};
+        std::atomic<uint64_t>    evictions {0};
+
+        std::function<void(const Key &, const Value &)> on_evict;
+
+        /// @brief Advance the CLOCK hand, giving referenced Entries a second chance and evicting
+        /// the first unreferenced one. Caller holds clock_mutex.
+        void evictOne() {
+            while (true) {
+                if (hand >= ring.size()) {
+                    hand = 0;
+                }
+
+                Slot &slot = ring[hand];
+
+                if (slot.entry && !slot.entry->referenced.exchange(false)) {
+                    if (on_evict) {
+                        on_evict(slot.key, *slot.entry->value);
+                    }
+                    map.erase(slot.key);
+                    bytes_used.fetch_sub(slot.entry->bytes, std::memory_order_relaxed);
+                    entries.fetch_sub(1, std::memory_order_relaxed);
+                    evictions.fetch_add(1, std::memory_order_relaxed);
+                    slot.entry.reset();
+                    free_slots.push_back(hand++);
+                    return;
+                }
+
+                ++hand;
+            }
+        }
+
+        /// @brief Evict until the Entry fits, then add it to the Ring. Caller holds clock_mutex.
+        auto insertLocked(const Key &key, std::shared_ptr<const Value> shared, std::size_t bytes)
+            -> std::shared_ptr<const Value> {
+            while (entries.load(std::memory_order_relaxed) >= capacity ||
+                   bytes_used.load(std::memory_order_relaxed) + bytes > byte_budget) {
+                evictOne();
+            }
+
+            auto entry = std::make_shared<Entry>(shared, bytes);
+
+            if (free_slots.empty()) {
+                entry->slot = ring.size();
+                ring.push_back({key, entry});
+            } else {
+                entry->slot = free_slots.back();
+                ring[entry->slot] = {key, entry};
+                free_slots.pop_back();
+            }
+
+            map.insert_or_assign(key, std::move(entry));
+            bytes_used.fetch_add(bytes, std::memory_order_relaxed);
+            entries.fetch_add(1, std::memory_order_relaxed);
+            inserts.fetch_add(1, std::memory_order_relaxed);
+
+            return shared;
+        }
+
+      public:
+        ClockCache(std::size_t capacity, std::size_t byte_budget)
+            : capacity(capacity),
+              byte_budget(byte_budget) {}
+
+        ClockCache(const ClockCache &)                     = delete;
+        ClockCache(ClockCache &&)                          = delete;
+        auto operator=(const ClockCache &) -> ClockCache & = delete;
+        auto operator=(ClockCache &&) -> ClockCache      & = delete;
+
+        /// @brief Wait-free Lookup - marks the Entry as recently used
+        /// @param key
+        /// @return std::shared_ptr<const Value> - nullptr on a Miss
+        auto find(const Key &key) const -> std::shared_ptr<const Value> {
+            auto it = map.find(key);
+            if (it == map.cend()) {
+                return nullptr;
+            }
+            it->second->referenced.store(true, std::memory_order_relaxed);
+            return it->second->value;
+        }
+
+        /// @brief Insert a Value accounted as `bytes`, evicting until it fits. If the Key is
+        /// already cached the existing Value is returned instead. A Value larger than the whole
+        /// Budget is returned without being cached.
+        /// @param key
+        /// @param value
+        /// @param bytes
+        /// @return std::shared_ptr<const Value>
+        auto insert(const Key &key, Value &&value, std::size_t bytes)
+            -> std::shared_ptr<const Value> {
+            auto shared = std::make_shared<const Value>(std::move(value));
+
+            if (bytes > byte_budget || capacity == 0) {
+                return shared;
+            }
+
+            std::lock_guard<std::mutex> lock(clock_mutex);
+
+            if (auto it = map.find(key); it != map.cend()) {
+                it->second->referenced.store(true, std::memory_order_relaxed);
+                return it->second->value;
+            }
+
+            return insertLocked(key, std::move(shared), bytes);
+        }
+
+        /// @brief Swap the Value cached under a Key for an updated one accounted as `bytes`, e.g.
+        /// after Results were added to it. Readers holding the old Value keep it. The Eviction
+        /// Listener is not called - the Key stays cached. Inserts the Value if the Key is not
+        /// cached.
+        /// @param key
+        /// @param value
+        /// @param bytes
+        /// @return std::shared_ptr<const Value>
+        auto replace(const Key &key, Value &&value, std::size_t bytes)
+            -> std::shared_ptr<const Value> {
+            auto shared = std::make_shared<const Value>(std::move(value));
+
+            if (bytes > byte_budget || capacity == 0) {
+                return shared;
+            }
+
+            std::lock_guard<std::mutex> lock(clock_mutex);
+
+            auto it = map.find(key);
+            if (it == map.cend()) {
+                return insertLocked(key, std::move(shared), bytes);
+            }
+
+            std::shared_ptr<Entry> previous = it->second;
+
+            auto entry  = std::make_shared<Entry>(shared, bytes);
+            entry->slot = previous->slot;
+
+            ring[entry->slot].entry = entry;
+            map.insert_or_assign(key, std::move(entry));
+            bytes_used.fetch_add(bytes, std::memory_order_relaxed);
+            bytes_used.fetch_sub(previous->bytes, std::memory_order_relaxed);
+
+            while (bytes_used.load(std::memory_order_relaxed) > byte_budget) {
+                evictOne();
+            }
+
+            return shared;
+        }
+
+        /// @brief Called with every Entry CLOCK evicts, under the Ring Lock - must not call back
+        /// into the Cache. Lets Indexes that point at cached Values shrink with the Cache.
+        /// reset() does not call it, clear such Indexes alongside.
+        /// @param listener
+        void onEvict(std::function<void(const Key &, const Value &)> listener) {
+            std::lock_guard<std::mutex> lock(clock_mutex);
+            on_evict = std::move(listener);
+        }
+
+        /// @brief Drop every Entry and apply new Bounds
+        void reset(std::size_t new_capacity, std::size_t new_byte_budget) {
+            std::lock_guard<std::mutex> lock(clock_mutex);
+            map.clear();
+            ring.clear();
+            free_slots.clear();
+            hand        = 0;
+            capacity    = new_capacity;
+            byte_budget = new_byte_budget;
+            entries.store(0, std::memory_order_relaxed);
+            bytes_used.store(0, std::memory_order_relaxed);
+        }
+
+        /// @brief Apply a new Byte Budget, evicting immediately if the Cache exceeds it
+        void setByteBudget(std::size_t new_byte_budget) {
+            std::lock_guard<std::mutex> lock(clock_mutex);
+            byte_budget = new_byte_budget;
+            while (bytes_used.load(std::memory_order_relaxed) > byte_budget) {
+                evictOne();
+            }
+        }
+
+        /// @brief Visit every cached Value - a consistent view is not guaranteed under writers
+        template <typename Fn>
+        void forEach(Fn &&fn) const {
+            for (const auto &[key, entry]: map) {
+                fn(key, *entry->value);
+            }
+        }
+
+        auto size() const -> std::size_t { return entries.load(std::memory_order_relaxed); }
+
+        auto bytes() const -> std::size_t { return bytes_used.load(std::memory_order_relaxed); }
+
+        auto maxEntries() const -> std::size_t { return capacity; }
+
+        auto maxBytes() const -> std::size_t { return byte_budget; }
+
+        /// @brief Entries inserted over the Cache's lifetime
+        auto insertCount() const -> uint64_t { return inserts.load(std::memory_order_relaxed); }
+
+        /// @brief Entries evicted by CLOCK over the Cache's lifetime
+        auto evictionCount() const -> uint64_t {
+            return evictions.load(std::memory_order_relaxed);
+        }
+    };
+
+#pragma endregion
+
+#pragma region SINGLE_FLIGHT              /* Deduplication of concurrent work per Key */
+
+    /// @brief Collapses concurrent calls for the same Key into one. The first caller (leader) runs
+    /// the Function, callers arriving while it is in flight block on the leader's result instead of
+    /// repeating the work. Exceptions thrown by the leader are rethrown to every waiter.
+    ///
+    /// @code{.cpp}
+    ///     SingleFlight<Sha256Digest, ImagePtr, DigestHasher> in_flight;
+    ///     auto [image, shared] = in_flight.run(sha, [&] { return recognize(data); });
+    /// @endcode
+    /// @note The leader should publish its result (e.g. to a Cache) before returning - a caller
+    /// that missed the Cache just as the flight landed becomes a new leader and must re-check it.
+    template <typename Key, typename Value, typename Hasher = std::hash<Key>>
+    class SingleFlight {
+        folly::ConcurrentHashMap<Key, std::shared_future<Value>, Hasher> calls;
+
+      public:
+        /// @brief Run `fn` for the Key or wait on the call already in flight
+        /// @return std::pair<Value, bool> - the Value and whether it came from another caller
+        template <typename Fn>
+        auto run(const Key &key, Fn &&fn) -> std::pair<Value, bool> {
+            std::promise<Value> promise;
+
+            auto [call, leader] = calls.try_emplace(key, promise.get_future().share());
+
+            if (!leader) {
+                std::shared_future<Value> pending = call->second;
+                return {pending.get(), true};
+            }
+
+            try {
+                Value value = std::forward<Fn>(fn)();
+                promise.set_value(value);
+                calls.erase(key);
+                return {std::move(value), false};
+            } catch (...) {
+                promise.set_exception(std::current_exception());
+                calls.erase(key);
+                throw;
+            }
+        }
+
+        /// @brief Number of Keys currently in flight
+        auto size() const -> std::size_t { return calls.size(); }
+    };
+
+#pragma endregion
+
+} // namespace imgstr
+
+#endif // CACHE_H
@@ -0,0 +1,56 @@
+// compress.h
+#ifndef COMPRESS_H
+#define COMPRESS_H
+
+#include <llvm/ADT/StringRef.h>
+#include <stdexcept>
+#include <string>
+#include <zlib.h>
+
+#pragma region TEXT_COMPRESSION           /* zlib Compression for cached Text */
+
+/// @brief Texts shorter than this are kept as is - the zlib header outweighs the savings
+static constexpr std::size_t MIN_COMPRESSIBLE_TEXT = 256;
+
+/// @brief Compress Text with zlib (fast level - OCR output is highly redundant already)
+/// @param text
+/// @return std::string - compressed Bytes
+inline auto compressText(llvm::StringRef text) -> std::string {
+    uLongf      packedSize = compressBound(text.size());
+    std::string packed(packedSize, '\0');
+
+    if (compress2(reinterpret_cast<Bytef *>(packed.data()),
+                  &packedSize,
+                  reinterpret_cast<const Bytef *>(text.data()),
+                  text.size(),
+                  Z_BEST_SPEED) != Z_OK) {
+        throw std::runtime_error("Failed to compress text");
+    }
+
+    packed.resize(packedSize);
+    packed.shrink_to_fit();
+    return packed;
+}
+
+/// @brief Decompress Text produced by compressText()
+/// @param packed
+/// @param original_size - Size of the Text before Compression
+/// @return std::string
+inline auto decompressText(llvm::StringRef packed, std::size_t original_size) -> std::string {
+    uLongf      textSize = original_size;
+    std::string text(original_size, '\0');
+
+    if (uncompress(reinterpret_cast<Bytef *>(text.data()),
+                   &textSize,
+                   reinterpret_cast<const Bytef *>(packed.data()),
+                   packed.size()) != Z_OK ||
+        textSize != original_size) {
+        throw std::runtime_error("Failed to decompress text");
+    }
+
+    return text;
+}
+
+#pragma endregion
+
+#endif // COMPRESS_H
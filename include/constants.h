@@ -3,18 +3,24 @@
 #ifndef CONSTANTS_H
 #define CONSTANTS_H
 
+#include <string>
 #include <string_view>
 #include <unordered_set>
 
 /// @brief Image Processing Mode or Document Processing Modes
 enum class ImgMode { document, image };
 
+/// @brief Speed / Accuracy Trade-off of the Tesseract Engines - bundles the OEM, Page
+/// Segmentation Mode and Engine Variables, see engineProfile() in ktesseract.h. balanced comes
+/// first - zeroed Fields written before Profiles existed read back as the Defaults.
+enum class OcrProfile { balanced, fast, accurate };
+
 /// @brief Core Capacity Enum
 enum class CORES { single, half, max };
 
 /// @brief  Valid Image File Extensions
 const std::unordered_set<std::string_view> validExtensions = {
-    "jpg", "jpeg", "png", "bmp", "gif", "tif"};
+    "jpg", "jpeg", "png", "bmp", "gif", "tif", "tiff"};
 
 /// @brief Supported Languages
 enum class ISOLang { en, es, fr, hi, zh, de };
@@ -28,6 +34,55 @@ namespace ISOLanguage {
     static constexpr auto hin = "hin";
 } // namespace ISOLanguage
 
+/// @brief Tesseract traineddata Name of a Supported Language
+/// @param lang
+/// @return const char* - e.g. "deu" for ISOLang::de
+constexpr auto isoToTesseractLang(ISOLang lang) -> const char * {
+    switch (lang) {
+        case ISOLang::es:
+            return ISOLanguage::esp;
+        case ISOLang::fr:
+            return ISOLanguage::fra;
+        case ISOLang::hi:
+            return ISOLanguage::hin;
+        case ISOLang::zh:
+            return ISOLanguage::chi;
+        case ISOLang::de:
+            return ISOLanguage::ger;
+        case ISOLang::en:
+        default:
+            return ISOLanguage::eng;
+    }
+}
+
+/// @brief Name of a Profile as used on the Command Line and in Logs
+/// @param profile
+/// @return const char* - "fast", "balanced" or "accurate"
+constexpr auto profileName(OcrProfile profile) -> const char * {
+    switch (profile) {
+        case OcrProfile::fast:
+            return "fast";
+        case OcrProfile::accurate:
+            return "accurate";
+        case OcrProfile::balanced:
+        default:
+            return "balanced";
+    }
+}
+
+/// @brief Key of the Engines for a Tesseract Language under a Profile - Engine Pools and Cache
+/// Keys are separated by it. The balanced Profile keeps the plain Language Code so existing
+/// Cache Keys stay valid.
+/// @param lang - Tesseract Language Code
+/// @param profile
+/// @return std::string - e.g. "deu" or "deu:fast"
+inline auto engineKey(const std::string &lang, OcrProfile profile) -> std::string {
+    if (profile == OcrProfile::balanced) {
+        return lang;
+    }
+    return lang + ':' + profileName(profile);
+}
+
 namespace Ansi {
     static constexpr auto BOLD             = "\x1b[1m";
     static constexpr auto ITALIC           = "\x1b[3m";
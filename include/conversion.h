@@ -29,10 +29,12 @@ void createPDF(const std::string &input_path, const std::string &output_path);
 auto extractTextFromImageFileLeptonica(const std::string &file_path,
                                        const std::string &lang = "eng") -> std::string;
 
-/// @brief Perform Text Extraction using the LSTM Algo suited for Fuzzy Matches
+/// @brief Perform Text Extraction using the LSTM Algo suited for Fuzzy Matches - runs on pooled
+/// Engines of the fast OcrProfile
 /// @param file_path
 /// @param lang
 /// @return std::string
+/// @throws std::runtime_error if the File cannot be read or an Engine fails to initialize
 auto extractTextLSTM(const std::string &file_path, const std::string &lang = "eng") -> std::string;
 
 /// @brief Convert Image Files to Text and return the Strings
@@ -2,6 +2,7 @@
 #ifndef CRYPTO_H
 #define CRYPTO_H
 
+#include "digest.h"
 #include "fs.h"
 #include <openssl/evp.h>
 #include <string>
@@ -11,55 +12,51 @@
 
 /// @brief Compute the SHA 256 Hash
 /// @param data
-/// @return std::string
-inline auto computeSHA256(const std::vector<unsigned char> &data) -> std::string {
-    EVP_MD_CTX *mdContext = EVP_MD_CTX_new();
-    if (mdContext == nullptr) {
-        throw std::runtime_error("Failed to create EVP_MD_CTX");
-    }
-
-    if (EVP_DigestInit_ex(mdContext, EVP_sha256(), nullptr) != 1) {
-        EVP_MD_CTX_free(mdContext);
-        throw std::runtime_error("Failed to initialize EVP Digest");
-    }
-
-    if (EVP_DigestUpdate(mdContext, data.data(), data.size()) != 1) {
-        EVP_MD_CTX_free(mdContext);
-        throw std::runtime_error("Failed to update digest");
-    }
-
-    std::vector<unsigned char> hash(EVP_MD_size(EVP_sha256()));
-
+/// @return Sha256Digest
+inline auto computeSHA256(const std::vector<unsigned char> &data) -> Sha256Digest {
+    Sha256Digest digest;
     unsigned int lengthOfHash = 0;
 
-    if (EVP_DigestFinal_ex(mdContext, hash.data(), &lengthOfHash) != 1) {
-        EVP_MD_CTX_free(mdContext);
-        throw std::runtime_error("Failed to finalize digest");
+    if (EVP_Digest(data.data(),
+                   data.size(),
+                   digest.bytes.data(),
+                   &lengthOfHash,
+                   EVP_sha256(),
+                   nullptr) != 1 ||
+        lengthOfHash != Sha256Digest::SIZE) {
+        throw std::runtime_error("Failed to compute SHA256 digest");
     }
 
-    EVP_MD_CTX_free(mdContext);
-
-    std::string result;
-
-    llvm::raw_string_ostream rso(result);
-    for (unsigned int i = 0; i < lengthOfHash; ++i) {
-        rso << llvm::format_hex_no_prefix(hash[i], 2);
-    }
-    return rso.str();
+    return digest;
 }
 
 /// @brief Compute the SHA 256 Hash - Overload to Map Input Bytes to a vec<uchar> for OpenSSL
 /// @param filePath
-/// @return std::string
-inline auto computeSHA256(const std::string &filePath) -> std::string {
+/// @return Sha256Digest - zeroed if the File could not be read
+inline auto computeSHA256(const std::string &filePath) -> Sha256Digest {
     auto fileContentOrErr = readFileUChar(filePath);
     if (!fileContentOrErr) {
         llvm::errs() << "Error: " << llvm::toString(fileContentOrErr.takeError()) << "\n";
-        return "";
+        return {};
     }
     return computeSHA256(fileContentOrErr.get());
 }
 
+/// @brief Cache Key of Image Bytes recognized in a Language. English Keys are the Content Digest
+/// itself so Keys persisted before Languages were honored stay valid.
+/// @param digest - SHA256 of the Image Bytes
+/// @param lang - Tesseract Language Code
+/// @return Sha256Digest - SHA256(digest || lang) for any other Language
+inline auto languageKey(const Sha256Digest &digest, llvm::StringRef lang) -> Sha256Digest {
+    if (lang == "eng") {
+        return digest;
+    }
+
+    std::vector<unsigned char> salted(digest.bytes.begin(), digest.bytes.end());
+    salted.insert(salted.end(), lang.bytes_begin(), lang.bytes_end());
+    return computeSHA256(salted);
+}
+
 #pragma endregion
 
 #endif // CRYPTO_H
\ No newline at end of file
@@ -0,0 +1,68 @@
+// digest.h
+#ifndef DIGEST_H
+#define DIGEST_H
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <llvm/ADT/StringRef.h>
+#include <optional>
+#include <ostream>
+#include <string>
+
+#pragma region DIGEST_TYPE                /* Fixed Size SHA256 Digest */
+
+/// @brief Binary SHA256 Digest - 32 Bytes held inline. Hex is only produced for Reports.
+struct Sha256Digest {
+    static constexpr std::size_t SIZE = 32;
+
+    std::array<uint8_t, SIZE> bytes {};
+
+    auto operator==(const Sha256Digest &other) const -> bool = default;
+
+    auto data() const -> const uint8_t * { return bytes.data(); }
+
+    /// @brief View over the raw Digest Bytes
+    auto view() const -> llvm::StringRef {
+        return {reinterpret_cast<const char *>(bytes.data()), SIZE};
+    }
+
+    /// @brief Lowercase Hex representation - 64 chars
+    auto toHex() const -> std::string {
+        static constexpr auto digits = "0123456789abcdef";
+
+        std::string hex(SIZE * 2, '\0');
+        for (std::size_t i = 0; i < SIZE; ++i) {
+            hex[2 * i]     = digits[bytes[i] >> 4];
+            hex[2 * i + 1] = digits[bytes[i] & 0x0F];
+        }
+        return hex;
+    }
+
+    /// @brief Construct from 32 raw Bytes - std::nullopt if the Size does not match
+    static auto fromBytes(llvm::StringRef raw) -> std::optional<Sha256Digest> {
+        if (raw.size() != SIZE) {
+            return std::nullopt;
+        }
+        Sha256Digest digest;
+        std::memcpy(digest.bytes.data(), raw.data(), SIZE);
+        return digest;
+    }
+
+    friend auto operator<<(std::ostream &os, const Sha256Digest &digest) -> std::ostream & {
+        return os << digest.toHex();
+    }
+};
+
+/// @brief SHA256 Output is uniformly distributed - the first Word is already a good Hash
+struct DigestHasher {
+    auto operator()(const Sha256Digest &digest) const noexcept -> std::size_t {
+        std::size_t hash = 0;
+        std::memcpy(&hash, digest.bytes.data(), sizeof(hash));
+        return hash;
+    }
+};
+
+#pragma endregion
+
+#endif // DIGEST_H
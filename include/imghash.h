@@ -0,0 +1,281 @@
+// imghash.h
+#ifndef IMGHASH_H
+#define IMGHASH_H
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <digest.h>
+#include <folly/SharedMutex.h>
+#include <llvm/ADT/StringRef.h>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <pix.h>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace imgstr {
+
+#pragma region PERCEPTUAL_HASH            /* dHash on a downscaled Pix */
+
+    /// @brief 256 bit Difference Hash (dHash) plus the Aspect Ratio of the Source Image.
+    /// Computed on a 17x16 grayscale thumbnail: each bit records whether a pixel is brighter than
+    /// its right neighbour, which survives re-encoding, rescaling and metadata changes. Cells of
+    /// a text Page average the Ink of a few Lines, so different Text in the same Layout flips far
+    /// more Bits than the default Radius - see imghash_test DifferentTextPagesDoNotMatch.
+    struct FuzzHash {
+        static constexpr int GRID  = 16;
+        static constexpr int WORDS = GRID * GRID / 64;
+
+        std::array<uint64_t, WORDS> bits {};
+        float                       aspect = 0.0F;
+
+        auto distance(const FuzzHash &other) const -> unsigned {
+            unsigned dist = 0;
+            for (int i = 0; i < WORDS; ++i) {
+                dist += std::popcount(bits[i] ^ other.bits[i]);
+            }
+            return dist;
+        }
+
+        /// @brief Hex Encoding stored in Image::content_fuzzhash - "<64 hex chars>:<aspect>"
+        auto toString() const -> std::string {
+            static constexpr auto digits = "0123456789abcdef";
+
+            std::string out;
+            out.reserve(WORDS * 16 + 12);
+            for (uint64_t word: bits) {
+                for (int shift = 60; shift >= 0; shift -= 4) {
+                    out.push_back(digits[(word >> shift) & 0x0F]);
+                }
+            }
+            out.push_back(':');
+            out.append(std::to_string(aspect));
+            return out;
+        }
+
+        static auto fromString(llvm::StringRef encoded) -> std::optional<FuzzHash> {
+            auto [hex, aspect] = encoded.split(':');
+            if (hex.size() != WORDS * 16) {
+                return std::nullopt;
+            }
+
+            FuzzHash hash;
+            for (int i = 0; i < WORDS; ++i) {
+                if (hex.substr(i * 16, 16).getAsInteger(16, hash.bits[i])) {
+                    return std::nullopt;
+                }
+            }
+
+            double ratio = 0;
+            if (aspect.getAsDouble(ratio)) {
+                return std::nullopt;
+            }
+            hash.aspect = static_cast<float>(ratio);
+            return hash;
+        }
+    };
+
+    /// @brief Compute the Perceptual Hash of a decoded Image
+    /// @param image
+    /// @return std::optional<FuzzHash> - std::nullopt if Leptonica could not downscale the Pix
+    inline auto computeFuzzHash(Pix *image) -> std::optional<FuzzHash> {
+        l_int32 width  = pixGetWidth(image);
+        l_int32 height = pixGetHeight(image);
+        if (width <= 0 || height <= 0) {
+            return std::nullopt;
+        }
+
+        PixPtr gray(pixConvertTo8(image, 0));
+        if (!gray) {
+            return std::nullopt;
+        }
+
+        PixPtr thumb(pixScaleToSize(gray.get(), FuzzHash::GRID + 1, FuzzHash::GRID));
+        if (!thumb) {
+            return std::nullopt;
+        }
+
+        FuzzHash hash;
+        hash.aspect = static_cast<float>(width) / static_cast<float>(height);
+
+        int bit = 0;
+        for (l_int32 y = 0; y < FuzzHash::GRID; ++y) {
+            l_uint32 left = 0;
+            pixGetPixel(thumb.get(), 0, y, &left);
+
+            for (l_int32 x = 1; x <= FuzzHash::GRID; ++x, ++bit) {
+                l_uint32 right = 0;
+                pixGetPixel(thumb.get(), x, y, &right);
+
+                if (left > right) {
+                    hash.bits[bit / 64] |= uint64_t {1} << (bit % 64);
+                }
+                left = right;
+            }
+        }
+
+        return hash;
+    }
+
+#pragma endregion
+
+#pragma region NEAR_DUPLICATE_INDEX       /* BK-Tree over Hamming Distance */
+
+    /// @brief Finds previously processed Images whose FuzzHash lies within a Hamming Radius.
+    /// Backed by a BK-Tree so a query only visits subtrees that can hold a match. Candidates must
+    /// also share the Aspect Ratio - rescaling keeps it, a different page layout rarely does.
+    /// A Tag partitions the Entries - a Query only matches Entries inserted with the same Tag.
+    /// Entries are removed with erase() when their Image leaves the Cache; removed Nodes stay as
+    /// Routing Tombstones until they outnumber the live ones and the Tree is rebuilt.
+    ///
+    /// @code{.cpp}
+    ///     NearDuplicateIndex index(8);
+    ///     index.insert(hash, digest, tag);
+    ///     if (auto match = index.findNearest(other, tag)) { ... }
+    /// @endcode
+    class NearDuplicateIndex {
+        struct Node {
+            FuzzHash                              hash;
+            Sha256Digest                          digest;
+            std::vector<std::pair<unsigned, int>> children; // (distance, node index)
+            uint32_t                              tag  = 0;
+            bool                                  live = true;
+        };
+
+        static constexpr float ASPECT_TOLERANCE = 0.02F;
+
+        std::vector<Node>                                   nodes;
+        std::unordered_map<Sha256Digest, int, DigestHasher> positions; // live Nodes by Digest
+        unsigned                                            radius;
+        mutable folly::SharedMutex                          mutex;
+
+        static auto sameAspect(const FuzzHash &a, const FuzzHash &b) -> bool {
+            return std::fabs(a.aspect - b.aspect) <=
+                   ASPECT_TOLERANCE * std::max(a.aspect, b.aspect);
+        }
+
+        /// @brief Add a Node - caller holds the writer Lock
+        void insertLocked(const FuzzHash &hash, const Sha256Digest &digest, uint32_t tag) {
+            if (positions.count(digest) > 0) {
+                return;
+            }
+
+            int node = static_cast<int>(nodes.size());
+
+            if (!nodes.empty()) {
+                int current = 0;
+                while (true) {
+                    unsigned dist     = nodes[current].hash.distance(hash);
+                    auto    &children = nodes[current].children;
+                    auto     child =
+                        std::find_if(children.begin(), children.end(), [dist](auto &c) {
+                            return c.first == dist;
+                        });
+
+                    if (child == children.end()) {
+                        children.emplace_back(dist, node);
+                        break;
+                    }
+                    current = child->second;
+                }
+            }
+
+            nodes.push_back({hash, digest, {}, tag});
+            positions[digest] = node;
+        }
+
+      public:
+        explicit NearDuplicateIndex(unsigned radius): radius(radius) {}
+
+        void insert(const FuzzHash &hash, const Sha256Digest &digest, uint32_t tag = 0) {
+            std::unique_lock<folly::SharedMutex> writerLock(mutex);
+            insertLocked(hash, digest, tag);
+        }
+
+        /// @brief Forget an Image - called when it is evicted from the Cache
+        /// @param digest
+        void erase(const Sha256Digest &digest) {
+            std::unique_lock<folly::SharedMutex> writerLock(mutex);
+
+            auto it = positions.find(digest);
+            if (it == positions.end()) {
+                return;
+            }
+            nodes[it->second].live = false;
+            positions.erase(it);
+
+            if (positions.size() * 2 >= nodes.size()) {
+                return;
+            }
+
+            std::vector<Node> old;
+            old.swap(nodes);
+            positions.clear();
+            for (const auto &node: old) {
+                if (node.live) {
+                    insertLocked(node.hash, node.digest, node.tag);
+                }
+            }
+        }
+
+        /// @brief Closest indexed Image with the Tag within the Radius
+        /// @param hash
+        /// @param tag
+        /// @return std::optional<Sha256Digest>
+        auto findNearest(const FuzzHash &hash, uint32_t tag = 0) const
+            -> std::optional<Sha256Digest> {
+            std::shared_lock<folly::SharedMutex> readerLock(mutex);
+
+            if (nodes.empty()) {
+                return std::nullopt;
+            }
+
+            std::optional<Sha256Digest> best;
+            unsigned                    bestDist = radius + 1;
+
+            std::vector<int> pending {0};
+            while (!pending.empty()) {
+                const Node &node = nodes[pending.back()];
+                pending.pop_back();
+
+                unsigned dist = node.hash.distance(hash);
+                if (node.live && node.tag == tag && dist < bestDist &&
+                    sameAspect(node.hash, hash)) {
+                    best     = node.digest;
+                    bestDist = dist;
+                }
+
+                for (const auto &[edge, child]: node.children) {
+                    if (edge + radius >= dist && edge <= dist + radius) {
+                        pending.push_back(child);
+                    }
+                }
+            }
+
+            return best;
+        }
+
+        void clear() {
+            std::unique_lock<folly::SharedMutex> writerLock(mutex);
+            nodes.clear();
+            positions.clear();
+        }
+
+        /// @brief Number of live Entries
+        auto size() const -> std::size_t {
+            std::shared_lock<folly::SharedMutex> readerLock(mutex);
+            return positions.size();
+        }
+    };
+
+#pragma endregion
+
+} // namespace imgstr
+
+#endif // IMGHASH_H
@@ -4,12 +4,83 @@
 #define KTESSERACT_H
 
 #include "constants.h"
+#include "pix.h"
+#include "traineddata.h"
 #include "util.h"
+#include <algorithm>
 #include <allheaders.h>
 #include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <exception>
 #include <memory>
+#include <mutex>
 #include <omp.h>
+#include <optional>
+#include <stdexcept>
+#include <string>
 #include <tesseract/baseapi.h>
+#include <tesseract/ocrclass.h>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#pragma region TESSERACT_PROFILES        /* Engine Settings behind each OcrProfile */
+
+/// @brief Everything an OcrProfile changes about an Engine. The OEM and the Variables are applied
+/// at Init - dictionary loading can only be switched off there - the Page Segmentation Mode per
+/// Recognition.
+struct EngineProfile {
+    tesseract::OcrEngineMode oem;
+    tesseract::PageSegMode   document_psm;
+    tesseract::PageSegMode   image_psm;
+    std::vector<std::string> variable_names;
+    std::vector<std::string> variable_values;
+
+    auto pageSegMode(ImgMode mode) const -> tesseract::PageSegMode {
+        return mode == ImgMode::image ? image_psm : document_psm;
+    }
+};
+
+/// @brief Engine Settings of a Profile
+///
+/// - fast     : LSTM only, no Dictionaries, no second Pass over inverted Lines - roughly 2-3x the
+///              Throughput of balanced on clean Scans, at a Cost on unusual Words and dark Text
+/// - balanced : Tesseract Defaults, a single Block per Document
+/// - accurate : full Layout Analysis for Documents as well, for multi Column Pages and Tables
+///
+/// @param profile
+/// @return const EngineProfile&
+inline auto engineProfile(OcrProfile profile) -> const EngineProfile & {
+    static const EngineProfile fast {tesseract::OEM_LSTM_ONLY,
+                                     tesseract::PSM_SINGLE_BLOCK,
+                                     tesseract::PSM_AUTO,
+                                     {"load_system_dawg",
+                                      "load_freq_dawg",
+                                      "load_punc_dawg",
+                                      "load_number_dawg",
+                                      "load_bigram_dawg",
+                                      "tessedit_do_invert"},
+                                     {"0", "0", "0", "0", "0", "0"}};
+
+    static const EngineProfile balanced {
+        tesseract::OEM_DEFAULT, tesseract::PSM_SINGLE_BLOCK, tesseract::PSM_AUTO, {}, {}};
+
+    static const EngineProfile accurate {
+        tesseract::OEM_DEFAULT, tesseract::PSM_AUTO, tesseract::PSM_AUTO, {}, {}};
+
+    switch (profile) {
+        case OcrProfile::fast:
+            return fast;
+        case OcrProfile::accurate:
+            return accurate;
+        case OcrProfile::balanced:
+        default:
+            return balanced;
+    }
+}
+
+#pragma endregion
 
 #pragma region TESSERACT_OPENMP          /* Tesseract Implementation for Thread Local Tesseracts'  */
 
@@ -42,16 +113,40 @@ struct TesseractOCR {
         }
     }
 
-    void init(const std::string &lang = "eng", ImgMode mode = ImgMode::document) {
+    /// @brief Initialize the Engine - from the Mapping of the Model if one is passed, otherwise
+    /// by loading the traineddata from the default tessdata Path. Either way the Engine builds
+    /// its own copy of the Model.
+    void init(const std::string &lang    = "eng",
+              ImgMode            mode    = ImgMode::document,
+              const TrainedData *model   = nullptr,
+              OcrProfile         profile = OcrProfile::balanced) {
         if (!ocrPtr) {
             serr << Ansi::WARNING << "Created New Tesseract" << Ansi::END << '\n';
-            auto ptr = std::make_unique<tesseract::TessBaseAPI>();
-            if (ptr->Init(nullptr, lang.c_str()) != 0) {
+            const EngineProfile &settings = engineProfile(profile);
+
+            auto ptr    = std::make_unique<tesseract::TessBaseAPI>();
+            int  status = model != nullptr ? ptr->Init(model->data(),
+                                                      static_cast<int>(model->size()),
+                                                      lang.c_str(),
+                                                      settings.oem,
+                                                      nullptr,
+                                                      0,
+                                                      &settings.variable_names,
+                                                      &settings.variable_values,
+                                                      false,
+                                                      nullptr)
+                                           : ptr->Init(nullptr,
+                                                       lang.c_str(),
+                                                       settings.oem,
+                                                       nullptr,
+                                                       0,
+                                                       &settings.variable_names,
+                                                       &settings.variable_values,
+                                                       false);
+            if (status != 0) {
                 throw std::runtime_error("Could not initialize tesseract.");
             }
-            if (mode == ImgMode::image) {
-                ptr->SetPageSegMode(tesseract::PSM_AUTO);
-            }
+            ptr->SetPageSegMode(settings.pageSegMode(mode));
             ocrPtr = std::move(ptr);
             TesseractThreadCount.fetch_add(1, std::memory_order_relaxed);
         }
@@ -83,35 +178,378 @@ inline TesseractOCR *getThreadLocalTesserat() {
 
 #pragma endregion
 
-/* Leptonica reads 40% + faster than OpenCV */
+#pragma region TESSERACT_POOL            /* Bounded Pool of Tesseract Engines */
+
+/// @brief Bounded Pool of initialized Tesseract Engines, independent of the calling Thread.
+/// Engines are created lazily up to the Capacity and checked out through a Lease that returns
+/// them on destruction - OpenMP Workers, std::thread and std::async callers share the same
+/// Engines, so the Engine Count of the Pool stays bounded and TessBaseAPI::Init is paid once per
+/// Engine. A caller blocks while every Engine is checked out.
+///
+/// @code{.cpp}
+///     TesseractPool pool(4);
+///     {
+///         auto engine = pool.acquire();
+///         engine->SetImage(pix);
+///     } // Engine returned to the Pool
+/// @endcode
+class TesseractPool {
+  public:
+    class Lease {
+        TesseractPool                *pool = nullptr;
+        std::unique_ptr<TesseractOCR> engine;
+
+      public:
+        Lease(TesseractPool *pool, std::unique_ptr<TesseractOCR> engine)
+            : pool(pool),
+              engine(std::move(engine)) {}
+
+        Lease(Lease &&) noexcept                     = default;
+        auto operator=(Lease &&) noexcept -> Lease & = delete;
+        Lease(const Lease &)                         = delete;
+        auto operator=(const Lease &) -> Lease &     = delete;
+
+        ~Lease() {
+            if (engine) {
+                pool->release(std::move(engine));
+            }
+        }
 
-/// @brief Creates a local threaded instance of a Tesseract and processes images converting them to
-/// Text.
-/// getThreadLocalTesserat() Retrives an instance of the Tesseract from local thread storage - to
-/// achieve high throughput
-/// @param file_content
-/// @param lang
+        auto operator->() const -> tesseract::TessBaseAPI * { return engine->ocrPtr.get(); }
+
+        auto operator*() const -> tesseract::TessBaseAPI & { return *engine->ocrPtr; }
+    };
+
+    explicit TesseractPool(std::size_t capacity,
+                           std::string lang    = "eng",
+                           OcrProfile  profile = OcrProfile::balanced)
+        : lang(std::move(lang)),
+          profile(profile),
+          capacity(std::max<std::size_t>(capacity, 1)) {}
+
+    TesseractPool(const TesseractPool &)                     = delete;
+    TesseractPool(TesseractPool &&)                          = delete;
+    auto operator=(const TesseractPool &) -> TesseractPool & = delete;
+    auto operator=(TesseractPool &&) -> TesseractPool      & = delete;
+
+    /// @brief Check out an Engine - reuses an idle one, initializes a new one while below
+    /// Capacity, and otherwise waits for one to be returned
+    /// @return Lease
+    /// @throws std::runtime_error if a new Engine fails to initialize
+    auto acquire() -> Lease {
+        std::unique_lock<std::mutex> lock(mutex);
+        available.wait(lock, [this] { return !idle.empty() || created < capacity; });
+
+        if (!idle.empty()) {
+            auto engine = std::move(idle.back());
+            idle.pop_back();
+            return {this, std::move(engine)};
+        }
+
+        ++created;
+        const TrainedData *shared = sharedModel();
+        lock.unlock();
+
+        // Init parses the traineddata - done outside the Lock so other callers are not stalled
+        try {
+            auto engine = std::make_unique<TesseractOCR>();
+            engine->init(lang, ImgMode::document, shared, profile);
+            return {this, std::move(engine)};
+        } catch (...) {
+            lock.lock();
+            --created;
+            available.notify_one();
+            throw;
+        }
+    }
+
+    /// @brief Initialize Engines up to `count` (capped at the Capacity) in parallel so the first
+    /// Requests do not pay for loading the traineddata
+    /// @param count
+    /// @return std::vector<double> - Init Time in ms of each Engine created by this call
+    /// @throws std::runtime_error if an Engine fails to initialize - the others stay pooled
+    auto warm(std::size_t count) -> std::vector<double> {
+        std::size_t        missing = 0;
+        const TrainedData *shared  = nullptr;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            count   = std::min(count, capacity);
+            missing = count > created ? count - created : 0;
+            created += missing;
+            shared = sharedModel();
+        }
+
+        std::vector<std::unique_ptr<TesseractOCR>> fresh(missing);
+        std::vector<std::exception_ptr>            errors(missing);
+        std::vector<double>                        init_ms(missing, 0.0);
+        std::vector<std::thread>                   workers;
+
+        for (std::size_t i = 0; i < missing; ++i) {
+            workers.emplace_back([&, i] {
+                auto start = getStartTime();
+                try {
+                    auto engine = std::make_unique<TesseractOCR>();
+                    engine->init(lang, ImgMode::document, shared, profile);
+                    fresh[i] = std::move(engine);
+                } catch (...) {
+                    errors[i] = std::current_exception();
+                }
+                init_ms[i] = getDuration(start);
+            });
+        }
+
+        for (auto &worker: workers) {
+            worker.join();
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            for (auto &engine: fresh) {
+                if (engine) {
+                    idle.push_back(std::move(engine));
+                } else {
+                    --created;
+                }
+            }
+        }
+        available.notify_all();
+
+        for (auto &error: errors) {
+            if (error) {
+                std::rethrow_exception(error);
+            }
+        }
+
+        return init_ms;
+    }
+
+    /// @brief Change the Capacity - idle Engines beyond it are freed now, checked out ones
+    /// when they are returned
+    void resize(std::size_t new_capacity) {
+        std::vector<std::unique_ptr<TesseractOCR>> dropped;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            capacity = std::max<std::size_t>(new_capacity, 1);
+            while (created > capacity && !idle.empty()) {
+                dropped.push_back(std::move(idle.back()));
+                idle.pop_back();
+                --created;
+            }
+        }
+        available.notify_all();
+    }
+
+    /// @brief Engines currently initialized, idle or checked out
+    auto size() const -> std::size_t {
+        std::lock_guard<std::mutex> lock(mutex);
+        return created;
+    }
+
+    auto maxSize() const -> std::size_t {
+        std::lock_guard<std::mutex> lock(mutex);
+        return capacity;
+    }
+
+    auto language() const -> const std::string & { return lang; }
+
+    auto ocrProfile() const -> OcrProfile { return profile; }
+
+    /// @brief Path of the memory mapped traineddata Engines are initialized from - empty if
+    /// Engines load the Model themselves
+    auto modelPath() const -> std::string {
+        std::lock_guard<std::mutex> lock(mutex);
+        return model ? model->path() : std::string();
+    }
+
+  private:
+    /// @brief Map the Model once per Pool. Engines initialized from the Mapping skip locating and
+    /// reading the File, not the per Engine Model; combined Languages ("eng+deu") cannot be
+    /// loaded from memory and keep the Path based Init. Caller holds mutex.
+    auto sharedModel() -> const TrainedData * {
+        if (!model_resolved) {
+            model_resolved = true;
+            if (lang.find('+') == std::string::npos) {
+                auto modelOrErr = TrainedData::map(lang);
+                if (modelOrErr) {
+                    model = std::move(modelOrErr.get());
+                } else {
+                    serrfmt("{0}Loading {1} from tessdata: {2}{3}\n",
+                            Ansi::WARNING,
+                            lang,
+                            llvm::toString(modelOrErr.takeError()),
+                            Ansi::END);
+                }
+            }
+        }
+        return model.get();
+    }
+
+    void release(std::unique_ptr<TesseractOCR> engine) {
+        engine->ocrPtr->Clear();
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (created <= capacity) {
+                idle.push_back(std::move(engine));
+            } else {
+                --created;
+            }
+        }
+        available.notify_one();
+    }
+
+    const std::string                          lang;
+    const OcrProfile                           profile;
+    mutable std::mutex                         mutex;
+    std::condition_variable                    available;
+    std::vector<std::unique_ptr<TesseractOCR>> idle;
+    std::size_t                                capacity;
+    std::size_t                                created = 0;
+    std::shared_ptr<const TrainedData>         model;
+    bool                                       model_resolved = false;
+};
+
+/// @brief One TesseractPool per Language and Profile, created on first use. Every Pool shares the
+/// same Capacity so switching between Spanish and German batches never tears Engines down.
+/// The Capacity is per Pool, not global: a Processor that has used L Languages with P Profiles
+/// may hold up to Capacity x L x P initialized Engines. Idle Pools keep their Engines until the
+/// LanguagePools is destroyed.
+///
+/// @code{.cpp}
+///     LanguagePools pools(4);
+///     auto text = getTextOCR(pools.get("deu", OcrProfile::fast), pix);
+/// @endcode
+class LanguagePools {
+    mutable std::mutex                                              mutex;
+    std::unordered_map<std::string, std::unique_ptr<TesseractPool>> pools;
+    std::size_t                                                     capacity;
+
+  public:
+    explicit LanguagePools(std::size_t capacity): capacity(capacity) {}
+
+    /// @brief Pool for a Tesseract Language Code - References stay valid for the Object's life
+    auto get(const std::string &lang, OcrProfile profile = OcrProfile::balanced)
+        -> TesseractPool & {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto                       &pool = pools[engineKey(lang, profile)];
+        if (!pool) {
+            pool = std::make_unique<TesseractPool>(capacity, lang, profile);
+        }
+        return *pool;
+    }
+
+    /// @brief Apply a new per Pool Capacity to every existing and future Pool
+    void resize(std::size_t new_capacity) {
+        std::lock_guard<std::mutex> lock(mutex);
+        capacity = new_capacity;
+        for (auto &[_, pool]: pools) {
+            pool->resize(new_capacity);
+        }
+    }
+
+    /// @brief Engines initialized across every Language
+    auto size() const -> std::size_t {
+        std::lock_guard<std::mutex> lock(mutex);
+        std::size_t                 engines = 0;
+        for (const auto &[_, pool]: pools) {
+            engines += pool->size();
+        }
+        return engines;
+    }
+};
+
+#pragma endregion
+
+#pragma region TESSERACT_DEADLINES       /* Time Budgets for a single Recognition */
+
+/// @brief Point in Time by which a Recognition must finish
+using OcrDeadline = std::chrono::steady_clock::time_point;
+
+/// @brief Thrown when a Recognition is cancelled at its Deadline - the partial Text is dropped
+class OcrTimeoutError: public std::runtime_error {
+  public:
+    using std::runtime_error::runtime_error;
+};
+
+/// @brief Run Recognition on the Image set on the Engine, cancelled through the ETEXT_DESC
+/// Monitor once the Deadline passes. Tesseract polls the cancel Callback between Words, so an
+/// Overrun is bounded by the Time of one Word - Layout Analysis itself is not interruptible.
+/// Without a Deadline this is a plain Recognize().
+/// @param engine - with Image and Page Segmentation Mode set
+/// @param deadline
+/// @throws OcrTimeoutError if Recognition was cancelled at the Deadline
+/// @throws std::runtime_error if Recognition fails before the Deadline
+inline void recognizeWithin(tesseract::TessBaseAPI &engine, std::optional<OcrDeadline> deadline) {
+    if (!deadline) {
+        if (engine.Recognize(nullptr) != 0) {
+            throw std::runtime_error("OCR failed");
+        }
+        return;
+    }
+
+    tesseract::ETEXT_DESC monitor;
+    monitor.cancel_this = &*deadline;
+    monitor.cancel      = [](void *cancel_this, int) -> bool {
+        return std::chrono::steady_clock::now() >= *static_cast<const OcrDeadline *>(cancel_this);
+    };
+
+    int status = engine.Recognize(&monitor);
+    if (status == 0) {
+        return; // finished in Time, or the Deadline passed after the last Word was read
+    }
+
+    if (std::chrono::steady_clock::now() >= *deadline) {
+        throw OcrTimeoutError("OCR deadline exceeded");
+    }
+    throw std::runtime_error("OCR failed");
+}
+
+#pragma endregion
+
+#pragma region TESSERACT_POOL_OCR        /* Recognition on pooled Engines */
+
+/// @brief Recognize an already decoded Pix on an Engine checked out of the Pool. The Pix stays
+/// owned by the caller.
+/// @param pool
+/// @param image
 /// @param img_mode
+/// @param deadline - cancel Recognition at this Point, see recognizeWithin()
 /// @return std::string
-inline std::string getTextOCR(const std::vector<unsigned char> &file_content,
-                              const std::string                &lang,
+/// @throws OcrTimeoutError if the Deadline passes first
+inline auto getTextOCR(TesseractPool             &pool,
+                       Pix                       *image,
+                       ImgMode                    img_mode = ImgMode::document,
+                       std::optional<OcrDeadline> deadline = std::nullopt) -> std::string {
+    auto engine = pool.acquire();
+
+    engine->SetPageSegMode(engineProfile(pool.ocrProfile()).pageSegMode(img_mode));
+    engine->SetImage(image);
+
+    if (deadline) {
+        recognizeWithin(*engine, deadline);
+    }
 
-                              ImgMode img_mode = ImgMode::document) {
-#ifdef _DEBUGAPP
+    std::unique_ptr<char[]> rawText(engine->GetUTF8Text());
+
+    return rawText ? std::string(rawText.get()) : std::string();
+}
+
+#pragma endregion
+
+/* Leptonica reads 40% + faster than OpenCV */
 
-#endif
+/// @brief Recognize an already decoded Pix with the Thread Local Tesseract. The Pix stays owned
+/// by the caller.
+/// @param image
+/// @param lang
+/// @param img_mode
+/// @return std::string
+inline std::string getTextOCR(Pix *image, const std::string &lang, ImgMode img_mode) {
     auto *tesseract = getThreadLocalTesserat();
 
     if (tesseract->ocrPtr == nullptr) {
         tesseract->init(lang, img_mode);
     }
 
-    Pix *image = pixReadMem(static_cast<const l_uint8 *>(file_content.data()), file_content.size());
-    if (image == nullptr) {
-        throw std::runtime_error("Failed to load image from memory "
-                                 "buffer");
-    }
-
     tesseract->ocrPtr->SetImage(image);
 
     char       *rawText = tesseract->ocrPtr->GetUTF8Text();
@@ -119,9 +557,25 @@ inline std::string getTextOCR(const std::vector<unsigned char> &file_content,
 
     delete[] rawText;
 
-    pixDestroy(&image);
     tesseract->ocrPtr->Clear();
     return outText;
+}
+
+/// @brief Creates a local threaded instance of a Tesseract and processes images converting them to
+/// Text.
+/// getThreadLocalTesserat() Retrives an instance of the Tesseract from local thread storage - to
+/// achieve high throughput
+/// @param file_content
+/// @param lang
+/// @param img_mode
+/// @return std::string
+inline std::string getTextOCR(const std::vector<unsigned char> &file_content,
+                              const std::string                &lang,
+
+                              ImgMode img_mode = ImgMode::document) {
+    PixPtr image = decodePix(file_content);
+
+    return getTextOCR(image.get(), lang, img_mode);
 };
 
 std::string getTextOCRNoClear(const std::vector<unsigned char> &file_content,
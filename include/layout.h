@@ -0,0 +1,117 @@
+// layout.h
+#ifndef LAYOUT_H
+#define LAYOUT_H
+
+#include <ktesseract.h>
+#include <memory>
+#include <optional>
+#include <pix.h>
+#include <string>
+#include <vector>
+
+namespace imgstr {
+
+#pragma region LAYOUT_PREFILTER           /* Recognize only the Text Regions of an Image */
+
+    /// @brief Which Layout Blocks are worth recognizing - see getTextOCRTextRegions()
+    struct LayoutOptions {
+        l_int32 min_width      = 16;    // px - narrower Blocks are Noise or Icons
+        l_int32 min_height     = 8;     // px - shorter Blocks cannot hold a Line of Text
+        float   min_area       = 0.0F;  // Fraction of the Image a Block must cover, 0 - any
+        float   full_page_area = 0.75F; // Text Blocks covering more - recognize the whole Image
+    };
+
+    /// @brief Pixel Rectangle of a Text Block found by Layout Analysis
+    struct TextRegion {
+        l_int32 x, y, width, height;
+    };
+
+    /// @brief Run Layout Analysis only and keep the Text Blocks large enough to recognize
+    /// @param engine - with the Image already set
+    /// @param image
+    /// @param options
+    /// @return std::vector<TextRegion> - in Layout (reading) Order
+    inline auto findTextRegions(tesseract::TessBaseAPI &engine,
+                                Pix                    *image,
+                                const LayoutOptions    &options) -> std::vector<TextRegion> {
+        Boxa *blocks = engine.GetComponentImages(tesseract::RIL_BLOCK, true, nullptr, nullptr);
+        if (blocks == nullptr) {
+            return {};
+        }
+
+        auto min_pixels = static_cast<float>(pixGetWidth(image)) * pixGetHeight(image) *
+                          options.min_area;
+
+        std::vector<TextRegion> regions;
+        for (l_int32 i = 0, count = boxaGetCount(blocks); i < count; ++i) {
+            TextRegion region {};
+            boxaGetBoxGeometry(blocks, i, &region.x, &region.y, &region.width, &region.height);
+
+            if (region.width >= options.min_width && region.height >= options.min_height &&
+                static_cast<float>(region.width) * region.height >= min_pixels) {
+                regions.push_back(region);
+            }
+        }
+        boxaDestroy(&blocks);
+
+        return regions;
+    }
+
+    /// @brief OCR for Photos and Diagrams - Layout Analysis first, then Recognition restricted
+    /// to the surviving Text Blocks, each set as a Rectangle and read as a single Block. Images
+    /// that are mostly Graphics skip most or all of the Recognizer, Images that turn out to be
+    /// mostly Text are recognized in one Pass as with getTextOCR().
+    /// @param pool
+    /// @param image
+    /// @param options
+    /// @param deadline - for all Regions together
+    /// @return std::string - Text of the Regions in reading Order, empty if none were found
+    /// @throws OcrTimeoutError if the Deadline passes first
+    inline auto getTextOCRTextRegions(TesseractPool             &pool,
+                                      Pix                       *image,
+                                      const LayoutOptions       &options  = {},
+                                      std::optional<OcrDeadline> deadline = std::nullopt)
+        -> std::string {
+        auto engine = pool.acquire();
+
+        engine->SetPageSegMode(tesseract::PSM_AUTO);
+        engine->SetImage(image);
+
+        auto regions = findTextRegions(*engine, image, options);
+
+        float text_area = 0;
+        for (const auto &region: regions) {
+            text_area += static_cast<float>(region.width) * region.height;
+        }
+
+        auto page_area = static_cast<float>(pixGetWidth(image)) * pixGetHeight(image);
+
+        if (text_area > page_area * options.full_page_area) {
+            recognizeWithin(*engine, deadline);
+
+            std::unique_ptr<char[]> rawText(engine->GetUTF8Text());
+            return rawText ? std::string(rawText.get()) : std::string();
+        }
+
+        engine->SetPageSegMode(tesseract::PSM_SINGLE_BLOCK);
+
+        std::string text;
+        for (const auto &region: regions) {
+            engine->SetRectangle(region.x, region.y, region.width, region.height);
+            if (deadline) {
+                recognizeWithin(*engine, deadline);
+            }
+
+            std::unique_ptr<char[]> rawText(engine->GetUTF8Text());
+            if (rawText) {
+                text += rawText.get();
+            }
+        }
+        return text;
+    }
+
+#pragma endregion
+
+} // namespace imgstr
+
+#endif // LAYOUT_H
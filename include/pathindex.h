@@ -0,0 +1,137 @@
+// pathindex.h
+#ifndef PATHINDEX_H
+#define PATHINDEX_H
+
+#include <cstdint>
+#include <digest.h>
+#include <folly/concurrency/ConcurrentHashMap.h>
+#include <algorithm>
+#include <llvm/Support/FileSystem.h>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+namespace imgstr {
+
+#pragma region PATH_INDEX                 /* Stat based File Identity -> Digest Index */
+
+    /// @brief Identity of a File's Contents as far as stat() can tell - any rewrite of the File
+    /// changes the size or modification time.
+    struct FileIdentity {
+        uint64_t device = 0;
+        uint64_t inode  = 0;
+        uint64_t size   = 0;
+        int64_t  mtime  = 0; // nanoseconds since epoch
+
+        auto operator==(const FileIdentity &other) const -> bool = default;
+
+        /// @brief stat() the Path - std::nullopt if it does not exist or is not readable
+        /// @param path
+        /// @return std::optional<FileIdentity>
+        static auto of(const llvm::Twine &path) -> std::optional<FileIdentity> {
+            llvm::sys::fs::file_status status;
+            if (llvm::sys::fs::status(path, status)) {
+                return std::nullopt;
+            }
+
+            auto uid = status.getUniqueID();
+
+            return FileIdentity {uid.getDevice(),
+                                 uid.getFile(),
+                                 status.getSize(),
+                                 status.getLastModificationTime().time_since_epoch().count()};
+        }
+    };
+
+    struct FileIdentityHasher {
+        auto operator()(const FileIdentity &id) const noexcept -> std::size_t {
+            std::size_t hash = id.inode;
+            hash ^= id.device + 0x9e3779b97f4a7c15ULL + (hash << 6) + (hash >> 2);
+            hash ^= id.size + 0x9e3779b97f4a7c15ULL + (hash << 6) + (hash >> 2);
+            hash ^= static_cast<uint64_t>(id.mtime) + 0x9e3779b97f4a7c15ULL + (hash << 6) +
+                    (hash >> 2);
+            return hash;
+        }
+    };
+
+    /// @brief Maps (device, inode, size, mtime) to the Digest of the File's Bytes so an unchanged
+    /// File can be resolved to its cached Image with a single stat() - no read and no SHA256.
+    /// Lookups are wait-free; writers keep a Digest -> Identities reverse Map under a Mutex so
+    /// erase() can drop the Identities of an Image that left the Cache.
+    ///
+    /// @code{.cpp}
+    ///     auto id = FileIdentity::of(path);
+    ///     if (auto digest = index.find(*id)) { auto img = cache.find(*digest); }
+    /// @endcode
+    class PathIndex {
+        folly::ConcurrentHashMap<FileIdentity, Sha256Digest, FileIdentityHasher> index;
+
+        std::mutex                                                                owners_mutex;
+        std::unordered_map<Sha256Digest, std::vector<FileIdentity>, DigestHasher> owners;
+
+        /// @brief Unlink an Identity from the Digest it resolved to - caller holds owners_mutex
+        void dropOwner(const Sha256Digest &digest, const FileIdentity &id) {
+            auto it = owners.find(digest);
+            if (it == owners.end()) {
+                return;
+            }
+            auto &ids = it->second;
+            ids.erase(std::remove(ids.begin(), ids.end(), id), ids.end());
+            if (ids.empty()) {
+                owners.erase(it);
+            }
+        }
+
+      public:
+        auto find(const FileIdentity &id) const -> std::optional<Sha256Digest> {
+            auto it = index.find(id);
+            if (it == index.cend()) {
+                return std::nullopt;
+            }
+            return it->second;
+        }
+
+        void insert(const FileIdentity &id, const Sha256Digest &digest) {
+            std::lock_guard<std::mutex> lock(owners_mutex);
+
+            if (auto previous = index.find(id); previous != index.cend()) {
+                if (previous->second == digest) {
+                    return;
+                }
+                dropOwner(previous->second, id);
+            }
+
+            index.insert_or_assign(id, digest);
+            owners[digest].push_back(id);
+        }
+
+        /// @brief Forget every Identity resolving to the Digest - called when its Image is evicted
+        /// @param digest
+        void erase(const Sha256Digest &digest) {
+            std::lock_guard<std::mutex> lock(owners_mutex);
+
+            auto it = owners.find(digest);
+            if (it == owners.end()) {
+                return;
+            }
+            for (const auto &id: it->second) {
+                index.erase(id);
+            }
+            owners.erase(it);
+        }
+
+        void clear() {
+            std::lock_guard<std::mutex> lock(owners_mutex);
+            index.clear();
+            owners.clear();
+        }
+
+        auto size() const -> std::size_t { return index.size(); }
+    };
+
+#pragma endregion
+
+} // namespace imgstr
+
+#endif // PATHINDEX_H
@@ -0,0 +1,92 @@
+// pix.h
+#ifndef PIX_H
+#define PIX_H
+
+#include <allheaders.h>
+#include <cstdio>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#pragma region LEPTONICA_UTILS            /* Leptonica Pix Ownership helpers */
+
+struct PixDeleter {
+    void operator()(Pix *pix) const { pixDestroy(&pix); }
+};
+
+/// @brief Owning Pointer to a Leptonica Pix - pixDestroy() runs when it goes out of Scope
+using PixPtr = std::unique_ptr<Pix, PixDeleter>;
+
+/// @brief Decode Image Bytes into a Pix
+/// @param file_content
+/// @return PixPtr
+/// @throws std::runtime_error if the Bytes are not a decodable Image
+inline auto decodePix(const std::vector<unsigned char> &file_content) -> PixPtr {
+    PixPtr image(
+        pixReadMem(static_cast<const l_uint8 *>(file_content.data()), file_content.size()));
+    if (image == nullptr) {
+        throw std::runtime_error("Failed to load image from memory "
+                                 "buffer");
+    }
+    return image;
+}
+
+/// @brief Decode every Page of Image Bytes - each Page of a multi-page TIFF, the single Image of
+/// any other Format. GIF decoding in Leptonica stops at the first Frame.
+/// @param file_content
+/// @return std::vector<PixPtr> - at least one Page, in File Order
+/// @throws std::runtime_error if the Bytes are not a decodable Image
+inline auto decodePages(const std::vector<unsigned char> &file_content) -> std::vector<PixPtr> {
+    std::vector<PixPtr> pages;
+
+    l_int32 format = IFF_UNKNOWN;
+    if (file_content.size() >= 12) { // findFileFormatBuffer() reads the first 12 Bytes
+        findFileFormatBuffer(static_cast<const l_uint8 *>(file_content.data()), &format);
+    }
+
+    if (L_FORMAT_IS_TIFF(format)) {
+        Pixa *pixa = pixaReadMemMultipageTiff(static_cast<const l_uint8 *>(file_content.data()),
+                                              file_content.size());
+        if (pixa != nullptr) {
+            for (l_int32 i = 0, count = pixaGetCount(pixa); i < count; ++i) {
+                if (Pix *page = pixaGetPix(pixa, i, L_CLONE)) {
+                    pages.emplace_back(page);
+                }
+            }
+            pixaDestroy(&pixa);
+        }
+    }
+
+    if (pages.empty()) {
+        pages.push_back(decodePix(file_content));
+    }
+    return pages;
+}
+
+/// @brief Number of Pages decodePages() yields for a File, read from the TIFF Directory Chain
+/// without decoding any Pixels
+/// @param path
+/// @return std::size_t - 1 for any other Format or an unreadable File
+inline auto countPages(const std::string &path) -> std::size_t {
+    l_int32 format = IFF_UNKNOWN;
+    if (findFileFormat(path.c_str(), &format) != 0 || !L_FORMAT_IS_TIFF(format)) {
+        return 1;
+    }
+
+    FILE *stream = fopenReadStream(path.c_str());
+    if (stream == nullptr) {
+        return 1;
+    }
+
+    l_int32 count = 1;
+    if (tiffGetCount(stream, &count) != 0 || count < 1) {
+        count = 1;
+    }
+    fclose(stream);
+    return static_cast<std::size_t>(count);
+}
+
+#pragma endregion
+
+#endif // PIX_H
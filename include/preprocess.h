@@ -0,0 +1,259 @@
+// preprocess.h
+#ifndef PREPROCESS_H
+#define PREPROCESS_H
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <numbers>
+#include <pix.h>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace imgstr {
+
+#pragma region PREPROCESS_PIPELINE        /* Leptonica Preprocessing ahead of Tesseract */
+
+    enum class Binarization {
+        otsu,   // tiled Otsu - fast, good for flatbed Scans
+        sauvola // local Mean/Deviation - tolerates Shadows and uneven Lighting in Photos
+    };
+
+    struct BinarizeOptions {
+        Binarization method      = Binarization::sauvola;
+        l_int32      tile_size   = 300;  // otsu - Tile Edge in Pixels
+        l_float32    score_fract = 0.1F; // otsu - Histogram Fraction treated as a tie
+        l_int32      window_half = 16;   // sauvola - half Width of the local Window
+        l_float32    factor      = 0.35; // sauvola - Weight of the local Deviation
+    };
+
+    /// @brief 1 bpp Ink Mask for Layout Analysis (Strip Cuts, x-height) - tiled Otsu as in
+    /// PreprocessPipeline::binarize(), so shaded Backgrounds do not turn into Ink as with a fixed
+    /// Threshold. A Mask that is mostly Ink is inverted - light Text on a dark Background.
+    /// 1 bpp Input is taken as is.
+    /// @param image
+    /// @return PixPtr - nullptr if the Image cannot be binarized
+    inline auto inkMask(Pix *image) -> PixPtr {
+        if (pixGetDepth(image) == 1) {
+            return PixPtr(pixClone(image));
+        }
+
+        PixPtr gray(pixConvertTo8(image, 0));
+        if (!gray) {
+            return nullptr;
+        }
+
+        BinarizeOptions options {.method = Binarization::otsu};
+        Pix            *binary = nullptr;
+        pixOtsuAdaptiveThreshold(gray.get(), options.tile_size, options.tile_size, 0, 0,
+                                 options.score_fract, nullptr, &binary);
+
+        PixPtr mask(binary);
+        if (!mask) {
+            return nullptr;
+        }
+
+        l_int32 ink = 0;
+        pixCountPixels(mask.get(), &ink, nullptr);
+        if (static_cast<int64_t>(ink) * 2 > static_cast<int64_t>(pixGetWidth(image)) *
+                                                pixGetHeight(image)) {
+            pixInvert(mask.get(), mask.get());
+        }
+        return mask;
+    }
+
+    /// @brief Accumulated Cost of one Pipeline Step
+    struct StepTiming {
+        std::string name;
+        uint64_t    runs     = 0;
+        uint64_t    skipped  = 0; // Runs where the Step left the Image unchanged
+        double      total_ms = 0;
+
+        auto meanMs() const -> double { return runs == 0 ? 0.0 : total_ms / runs; }
+    };
+
+    /// @brief Ordered, individually timed Pix Transformations applied before SetImage. By
+    /// default Tesseract receives the decoded Pix and thresholds full Color Data itself - a
+    /// 1 bpp Image skips that internal Work and a fraction of its Memory.
+    ///
+    /// run() is safe to call concurrently, Steps must not be added while Images are processed.
+    ///
+    /// @code{.cpp}
+    ///     PreprocessPipeline pipeline;
+    ///     pipeline.grayscale().binarize({.method = Binarization::sauvola}).deskew();
+    ///     processor.setPreprocessing(std::move(pipeline));
+    /// @endcode
+    class PreprocessPipeline {
+      public:
+        /// @brief Returns the transformed Pix, or nullptr to pass the Input on unchanged
+        using Transform = std::function<PixPtr(Pix *)>;
+
+        /// @brief Append a custom Step
+        /// @param name - reported by timings()
+        /// @param transform
+        /// @param moves_pixels - the Step rotates, crops or warps the Page, so Positions found
+        /// on its Output do not map back to the Input by Scale alone
+        /// @return PreprocessPipeline& - for chaining
+        auto add(std::string name, Transform transform, bool moves_pixels = false)
+            -> PreprocessPipeline & {
+            steps.push_back({std::move(name), std::move(transform), moves_pixels,
+                             std::make_unique<Counters>()});
+            return *this;
+        }
+
+        /// @brief Convert to 8 bpp Grayscale, removing any Colormap
+        auto grayscale() -> PreprocessPipeline & {
+            return add("grayscale", [](Pix *pix) -> PixPtr {
+                if (pixGetDepth(pix) == 8 && pixGetColormap(pix) == nullptr) {
+                    return nullptr;
+                }
+                return PixPtr(pixConvertTo8(pix, 0));
+            });
+        }
+
+        /// @brief Threshold to 1 bpp with a locally adaptive Threshold. Non 8 bpp Input is
+        /// converted to Grayscale first, 1 bpp Input is left alone.
+        /// @param options
+        auto binarize(const BinarizeOptions &options = {}) -> PreprocessPipeline & {
+            return add("binarize", [options](Pix *pix) -> PixPtr {
+                if (pixGetDepth(pix) == 1) {
+                    return nullptr;
+                }
+
+                PixPtr gray;
+                if (pixGetDepth(pix) != 8 || pixGetColormap(pix) != nullptr) {
+                    gray.reset(pixConvertTo8(pix, 0));
+                    pix = gray.get();
+                }
+
+                Pix *binary = nullptr;
+                if (options.method == Binarization::otsu) {
+                    pixOtsuAdaptiveThreshold(pix, options.tile_size, options.tile_size, 0, 0,
+                                             options.score_fract, nullptr, &binary);
+                } else {
+                    pixSauvolaBinarizeTiled(pix, options.window_half, options.factor, 1, 1,
+                                            nullptr, &binary);
+                }
+                return PixPtr(binary);
+            });
+        }
+
+        /// @brief Measure the Skew Angle and rotate the Page level. Tesseract tolerates small
+        /// Skew, but Line finding degrades past a Degree or two. Pages whose Skew is too small
+        /// or too uncertain to act on are passed on unchanged and counted as skipped. The Step
+        /// moves Pixels, so it is left out when Word Boxes are collected.
+        /// @param reduction - Downsampling for the Angle Search (1, 2, 4 or 8), 0 for Leptonica's
+        /// Default
+        auto deskew(l_int32 reduction = 0) -> PreprocessPipeline & {
+            return add(
+                "deskew",
+                [reduction](Pix *pix) -> PixPtr {
+                    static constexpr l_int32   sweep_reduction = 4; // pixDeskew() Defaults
+                    static constexpr l_int32   search_default  = 2;
+                    static constexpr l_float32 sweep_range     = 7.0F; // Degrees from level
+                    static constexpr l_float32 sweep_delta     = 1.0F;
+                    static constexpr l_float32 min_search      = 0.01F;
+                    static constexpr l_float32 min_confidence  = 3.0F;
+                    static constexpr l_float32 min_angle       = 0.1F; // Degrees
+
+                    l_int32 search = reduction == 0 ? search_default : reduction;
+
+                    PixPtr mask = inkMask(pix);
+                    if (!mask) {
+                        return nullptr;
+                    }
+
+                    l_float32 angle      = 0;
+                    l_float32 confidence = 0;
+                    if (pixFindSkewSweepAndSearch(mask.get(), &angle, &confidence,
+                                                  std::max(sweep_reduction, search), search,
+                                                  sweep_range, sweep_delta, min_search) != 0 ||
+                        confidence < min_confidence || std::abs(angle) < min_angle) {
+                        return nullptr;
+                    }
+
+                    return PixPtr(pixRotate(pix, angle * std::numbers::pi_v<l_float32> / 180.0F,
+                                            L_ROTATE_AREA_MAP, L_BRING_IN_WHITE, 0, 0));
+                },
+                true);
+        }
+
+        auto empty() const -> bool { return steps.empty(); }
+
+        /// @brief Apply every Step in Order. A Step returning nullptr (no Change or a Failure)
+        /// passes its Input on to the next Step.
+        /// @param image - not modified
+        /// @param keep_geometry - leave out Steps that move Pixels, e.g. when Word Boxes are read
+        /// @return PixPtr - the final Image, nullptr if no Step changed image
+        auto run(Pix *image, bool keep_geometry = false) const -> PixPtr {
+            PixPtr current;
+
+            for (const auto &step: steps) {
+                if (keep_geometry && step.moves_pixels) {
+                    continue;
+                }
+
+                auto start = std::chrono::steady_clock::now();
+
+                PixPtr next = step.transform(current ? current.get() : image);
+
+                auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
+                    std::chrono::steady_clock::now() - start);
+
+                step.counters->runs.fetch_add(1, std::memory_order_relaxed);
+                step.counters->elapsed_us.fetch_add(static_cast<uint64_t>(elapsed.count()),
+                                                    std::memory_order_relaxed);
+
+                if (next) {
+                    current = std::move(next);
+                } else {
+                    step.counters->skipped.fetch_add(1, std::memory_order_relaxed);
+                }
+            }
+
+            return current;
+        }
+
+        /// @brief Time spent in each Step since the Pipeline was built, in Step Order
+        /// @return std::vector<StepTiming>
+        auto timings() const -> std::vector<StepTiming> {
+            std::vector<StepTiming> result;
+            result.reserve(steps.size());
+
+            for (const auto &step: steps) {
+                const Counters &counters = *step.counters;
+
+                result.push_back({step.name, counters.runs.load(std::memory_order_relaxed),
+                                  counters.skipped.load(std::memory_order_relaxed),
+                                  counters.elapsed_us.load(std::memory_order_relaxed) / 1000.0});
+            }
+            return result;
+        }
+
+      private:
+        struct Counters {
+            std::atomic<uint64_t> runs {0};
+            std::atomic<uint64_t> skipped {0};
+            std::atomic<uint64_t> elapsed_us {0};
+        };
+
+        struct Step {
+            std::string               name;
+            Transform                 transform;
+            bool                      moves_pixels;
+            std::unique_ptr<Counters> counters; // stable Address, Pipeline stays movable
+        };
+
+        std::vector<Step> steps;
+    };
+
+#pragma endregion
+
+} // namespace imgstr
+
+#endif // PREPROCESS_H
@@ -0,0 +1,322 @@
+// render.h
+#ifndef RENDER_H
+#define RENDER_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <llvm/Support/Error.h>
+#include <llvm/Support/FileSystem.h>
+#include <llvm/Support/Format.h>
+#include <llvm/Support/raw_ostream.h>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <vector>
+#include <words.h>
+
+namespace imgstr {
+
+#pragma region OUTPUT_RENDERERS           /* hOCR, TSV and ALTO streamed from OcrWords */
+
+    /// @brief Output Format of a Batch - see ImgProcessor::convertImagesToTextFilesParallel()
+    enum class OutputFormat { text, hocr, tsv, alto };
+
+    /// @brief File Extension of an Output Format, as written by the Tesseract CLI
+    constexpr auto formatExtension(OutputFormat format) -> const char * {
+        switch (format) {
+            case OutputFormat::hocr:
+                return ".hocr";
+            case OutputFormat::tsv:
+                return ".tsv";
+            case OutputFormat::alto:
+                return ".xml";
+            case OutputFormat::text:
+                break;
+        }
+        return ".txt";
+    }
+
+    namespace detail {
+        /// @brief End of the Run of equal Ids starting at begin, at most end
+        inline auto runEnd(const std::vector<uint32_t> &ids, std::size_t begin, std::size_t end)
+            -> std::size_t {
+            std::size_t i = begin;
+            while (i < end && ids[i] == ids[begin]) {
+                ++i;
+            }
+            return i;
+        }
+
+        /// @brief Union of the Boxes of Words [begin, end)
+        inline auto spanBox(const OcrWords &words, std::size_t begin, std::size_t end)
+            -> WordBox {
+            WordBox span = words.boxes[begin];
+            for (std::size_t i = begin + 1; i < end; ++i) {
+                span.left   = std::min(span.left, words.boxes[i].left);
+                span.top    = std::min(span.top, words.boxes[i].top);
+                span.right  = std::max(span.right, words.boxes[i].right);
+                span.bottom = std::max(span.bottom, words.boxes[i].bottom);
+            }
+            return span;
+        }
+
+        /// @brief Write Text escaped for XML Content and Attributes
+        inline void writeEscaped(llvm::raw_ostream &os, std::string_view text) {
+            for (char c: text) {
+                switch (c) {
+                    case '&':
+                        os << "&amp;";
+                        break;
+                    case '<':
+                        os << "&lt;";
+                        break;
+                    case '>':
+                        os << "&gt;";
+                        break;
+                    case '"':
+                        os << "&quot;";
+                        break;
+                    case '\'':
+                        os << "&#39;";
+                        break;
+                    default:
+                        os << c;
+                }
+            }
+        }
+
+        inline void writeBbox(llvm::raw_ostream &os, const WordBox &box) {
+            os << "bbox " << box.left << ' ' << box.top << ' ' << box.right << ' ' << box.bottom;
+        }
+
+        inline void writeAltoPosition(llvm::raw_ostream &os, const WordBox &box) {
+            os << "HPOS=\"" << box.left << "\" VPOS=\"" << box.top << "\" WIDTH=\""
+               << box.right - box.left << "\" HEIGHT=\"" << box.bottom - box.top << '"';
+        }
+    } // namespace detail
+
+    /// @brief Write the Words as an hOCR Page - Blocks become ocr_carea with a single ocr_par,
+    /// Lines ocr_line and Words ocrx_word with their Confidence as x_wconf
+    /// @param os
+    /// @param words
+    /// @param image_name - Title and image Property of the Page
+    inline void writeHOCR(llvm::raw_ostream &os,
+                          const OcrWords    &words,
+                          std::string_view   image_name) {
+        os << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+              "<!DOCTYPE html PUBLIC \"-//W3C//DTD XHTML 1.0 Transitional//EN\"\n"
+              "    \"http://www.w3.org/TR/xhtml1/DTD/xhtml1-transitional.dtd\">\n"
+              "<html xmlns=\"http://www.w3.org/1999/xhtml\" xml:lang=\"en\" lang=\"en\">\n"
+              " <head>\n  <title>";
+        detail::writeEscaped(os, image_name);
+        os << "</title>\n"
+              "  <meta http-equiv=\"Content-Type\" content=\"text/html;charset=utf-8\"/>\n"
+              "  <meta name=\"ocr-system\" content=\"tesseract\"/>\n"
+              "  <meta name=\"ocr-capabilities\" "
+              "content=\"ocr_page ocr_carea ocr_par ocr_line ocrx_word\"/>\n"
+              " </head>\n <body>\n"
+              "  <div class=\"ocr_page\" id=\"page_1\" title=\"image &quot;";
+        detail::writeEscaped(os, image_name);
+        os << "&quot;; ";
+        detail::writeBbox(os, {0, 0, words.page_width, words.page_height});
+        os << "; ppageno 0\">\n";
+
+        std::size_t block_no = 0, line_no = 0;
+        for (std::size_t b = 0, b_end = 0; b < words.size(); b = b_end) {
+            b_end = detail::runEnd(words.block_ids, b, words.size());
+            ++block_no;
+
+            auto block = detail::spanBox(words, b, b_end);
+            os << "   <div class=\"ocr_carea\" id=\"block_1_" << block_no << "\" title=\"";
+            detail::writeBbox(os, block);
+            os << "\">\n    <p class=\"ocr_par\" id=\"par_1_" << block_no << "\" title=\"";
+            detail::writeBbox(os, block);
+            os << "\">\n";
+
+            for (std::size_t l = b, l_end = 0; l < b_end; l = l_end) {
+                l_end = detail::runEnd(words.line_ids, l, b_end);
+                ++line_no;
+
+                os << "     <span class=\"ocr_line\" id=\"line_1_" << line_no << "\" title=\"";
+                detail::writeBbox(os, detail::spanBox(words, l, l_end));
+                os << "\">\n";
+
+                for (std::size_t w = l; w < l_end; ++w) {
+                    os << "      <span class=\"ocrx_word\" id=\"word_1_" << w + 1 << "\" title=\"";
+                    detail::writeBbox(os, words.boxes[w]);
+                    os << "; x_wconf " << static_cast<int>(words.confidences[w]) << "\">";
+                    detail::writeEscaped(os, words.word(w));
+                    os << "</span>\n";
+                }
+                os << "     </span>\n";
+            }
+            os << "    </p>\n   </div>\n";
+        }
+
+        os << "  </div>\n </body>\n</html>\n";
+    }
+
+    /// @brief Write the Words in the Column Layout of `tesseract image out tsv` - a Row per Page,
+    /// Block, Paragraph, Line and Word. Each Block holds a single Paragraph.
+    /// @param os
+    /// @param words
+    inline void writeTSV(llvm::raw_ostream &os, const OcrWords &words) {
+        auto row = [&os](int level, std::size_t block, std::size_t line, std::size_t word,
+                         const WordBox &box, float conf, std::string_view text) {
+            os << level << "\t1\t" << block << '\t' << (level >= 3 ? 1 : 0) << '\t' << line << '\t'
+               << word << '\t' << box.left << '\t' << box.top << '\t' << box.right - box.left
+               << '\t' << box.bottom - box.top << '\t';
+            if (level == 5) {
+                os << llvm::format("%.6f", conf);
+            } else {
+                os << -1;
+            }
+            os << '\t' << text << '\n';
+        };
+
+        os << "level\tpage_num\tblock_num\tpar_num\tline_num\tword_num\tleft\ttop\twidth\theight"
+              "\tconf\ttext\n";
+        row(1, 0, 0, 0, {0, 0, words.page_width, words.page_height}, 0, "");
+
+        for (std::size_t b = 0, b_end = 0, block_no = 1; b < words.size(); b = b_end, ++block_no) {
+            b_end = detail::runEnd(words.block_ids, b, words.size());
+
+            auto block = detail::spanBox(words, b, b_end);
+            row(2, block_no, 0, 0, block, 0, "");
+            row(3, block_no, 0, 0, block, 0, "");
+
+            for (std::size_t l = b, l_end = 0, line_no = 1; l < b_end; l = l_end, ++line_no) {
+                l_end = detail::runEnd(words.line_ids, l, b_end);
+                row(4, block_no, line_no, 0, detail::spanBox(words, l, l_end), 0, "");
+
+                for (std::size_t w = l; w < l_end; ++w) {
+                    row(5, block_no, line_no, w - l + 1, words.boxes[w], words.confidences[w],
+                        words.word(w));
+                }
+            }
+        }
+    }
+
+    /// @brief Write the Words as an ALTO v3 Document with one Page - Blocks become TextBlock,
+    /// Lines TextLine and Words String with their Confidence as WC in [0, 1]
+    /// @param os
+    /// @param words
+    /// @param image_name - sourceImageInformation fileName
+    inline void writeALTO(llvm::raw_ostream &os,
+                          const OcrWords    &words,
+                          std::string_view   image_name) {
+        os << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+              "<alto xmlns=\"http://www.loc.gov/standards/alto/ns-v3#\" "
+              "xmlns:xsi=\"http://www.w3.org/2001/XMLSchema-instance\" "
+              "xsi:schemaLocation=\"http://www.loc.gov/standards/alto/ns-v3# "
+              "http://www.loc.gov/alto/v3/alto-3-0.xsd\">\n"
+              " <Description>\n"
+              "  <MeasurementUnit>pixel</MeasurementUnit>\n"
+              "  <sourceImageInformation>\n   <fileName>";
+        detail::writeEscaped(os, image_name);
+        os << "</fileName>\n  </sourceImageInformation>\n"
+              "  <OCRProcessing ID=\"OCR_0\">\n   <ocrProcessingStep>\n"
+              "    <processingSoftware><softwareName>tesseract</softwareName>"
+              "</processingSoftware>\n"
+              "   </ocrProcessingStep>\n  </OCRProcessing>\n"
+              " </Description>\n <Layout>\n";
+
+        WordBox page {0, 0, words.page_width, words.page_height};
+        os << "  <Page WIDTH=\"" << page.right << "\" HEIGHT=\"" << page.bottom
+           << "\" PHYSICAL_IMG_NR=\"0\" ID=\"page_0\">\n   <PrintSpace ";
+        detail::writeAltoPosition(os, page);
+        os << ">\n";
+
+        std::size_t block_no = 0, line_no = 0;
+        for (std::size_t b = 0, b_end = 0; b < words.size(); b = b_end) {
+            b_end = detail::runEnd(words.block_ids, b, words.size());
+
+            os << "    <TextBlock ID=\"block_" << block_no++ << "\" ";
+            detail::writeAltoPosition(os, detail::spanBox(words, b, b_end));
+            os << ">\n";
+
+            for (std::size_t l = b, l_end = 0; l < b_end; l = l_end) {
+                l_end = detail::runEnd(words.line_ids, l, b_end);
+
+                os << "     <TextLine ID=\"line_" << line_no++ << "\" ";
+                detail::writeAltoPosition(os, detail::spanBox(words, l, l_end));
+                os << ">\n";
+
+                for (std::size_t w = l; w < l_end; ++w) {
+                    if (w > l) {
+                        os << "      <SP WIDTH=\""
+                           << words.boxes[w].left - words.boxes[w - 1].right << "\" VPOS=\""
+                           << words.boxes[w - 1].top << "\" HPOS=\"" << words.boxes[w - 1].right
+                           << "\"/>\n";
+                    }
+                    os << "      <String ID=\"string_" << w << "\" ";
+                    detail::writeAltoPosition(os, words.boxes[w]);
+                    os << " WC=\"" << llvm::format("%.2f", words.confidences[w] / 100.0F)
+                       << "\" CONTENT=\"";
+                    detail::writeEscaped(os, words.word(w));
+                    os << "\"/>\n";
+                }
+                os << "     </TextLine>\n";
+            }
+            os << "    </TextBlock>\n";
+        }
+
+        os << "   </PrintSpace>\n  </Page>\n </Layout>\n</alto>\n";
+    }
+
+    /// @brief Stream the Words of an Image to a File in a structured Format. Nothing is built
+    /// in Memory beyond the Stream Buffer, so large Pages cost no more than their OcrWords.
+    /// @param file_path
+    /// @param format - hocr, tsv or alto, others are rejected before file_path is opened
+    /// @param words
+    /// @param image_name
+    /// @return llvm::Error
+    inline auto writeOcrFile(const std::string &file_path,
+                             OutputFormat       format,
+                             const OcrWords    &words,
+                             std::string_view   image_name) -> llvm::Error {
+        if (format != OutputFormat::hocr && format != OutputFormat::tsv &&
+            format != OutputFormat::alto) {
+            return llvm::make_error<llvm::StringError>(
+                "Plain Text is written from the Image Text, not its Words",
+                std::make_error_code(std::errc::invalid_argument));
+        }
+
+        std::error_code      ERR;
+        llvm::raw_fd_ostream outstream(file_path, ERR, llvm::sys::fs::OF_None);
+
+        if (ERR) {
+            return llvm::make_error<llvm::StringError>(
+                "Failed to open file for writing: " + file_path, ERR);
+        }
+
+        switch (format) {
+            case OutputFormat::hocr:
+                writeHOCR(outstream, words, image_name);
+                break;
+            case OutputFormat::tsv:
+                writeTSV(outstream, words);
+                break;
+            case OutputFormat::alto:
+                writeALTO(outstream, words, image_name);
+                break;
+            case OutputFormat::text:
+                break;
+        }
+
+        outstream.close();
+
+        if (outstream.has_error()) {
+            return llvm::make_error<llvm::StringError>("Failed to write to file: " + file_path,
+                                                       outstream.error());
+        }
+
+        return llvm::Error::success();
+    }
+
+#pragma endregion
+
+} // namespace imgstr
+
+#endif // RENDER_H
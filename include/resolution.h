@@ -0,0 +1,105 @@
+// resolution.h
+#ifndef RESOLUTION_H
+#define RESOLUTION_H
+
+#include <algorithm>
+#include <pix.h>
+#include <preprocess.h>
+#include <vector>
+
+namespace imgstr {
+
+#pragma region RESOLUTION_NORMALIZATION   /* Downscale oversized Images before OCR */
+
+    /// @brief Target Size for normalizeResolution(). Tesseract is most accurate around an
+    /// x-height of 20-30 px, anything larger only adds Pixels to classify.
+    struct ResolutionOptions {
+        l_int32 target_x_height = 24;   // px - height of lowercase Letters after scaling
+        l_int32 target_dpi      = 300;  // used when no x-height can be estimated
+        float   min_scale       = 0.25; // never shrink further than this
+        float   max_scale       = 0.85; // skip scaling that would save less than ~30% Pixels
+    };
+
+    /// @brief Estimate the x-height of the Text on a Page as the median Height of letter sized
+    /// Connected Components. Components far too small (Noise, Dots) or too large (Rules,
+    /// Pictures) relative to the Page are ignored. Components are taken from the inkMask(), so
+    /// Text on a shaded or dark Background is measured too.
+    /// @param image
+    /// @return l_int32 - x-height in Pixels, 0 if the Page has too few Components to tell
+    inline auto estimateXHeight(Pix *image) -> l_int32 {
+        PixPtr binary = inkMask(image);
+        if (!binary) {
+            return 0;
+        }
+
+        Boxa *components = pixConnComp(binary.get(), nullptr, 8);
+        if (components == nullptr) {
+            return 0;
+        }
+
+        l_int32 max_height = std::max<l_int32>(8, pixGetHeight(image) / 8);
+        l_int32 count      = boxaGetCount(components);
+
+        std::vector<l_int32> heights;
+        heights.reserve(count);
+
+        for (l_int32 i = 0; i < count; ++i) {
+            l_int32 x = 0, y = 0, w = 0, h = 0;
+            boxaGetBoxGeometry(components, i, &x, &y, &w, &h);
+
+            // letters are roughly as wide as they are tall
+            if (h >= 4 && h <= max_height && w <= 3 * h && h <= 4 * w) {
+                heights.push_back(h);
+            }
+        }
+        boxaDestroy(&components);
+
+        if (heights.size() < 16) {
+            return 0;
+        }
+
+        auto median = heights.begin() + heights.size() / 2;
+        std::nth_element(heights.begin(), median, heights.end());
+        return *median;
+    }
+
+    /// @brief Scale Factor that brings the Page to options.target_x_height, falling back to the
+    /// Resolution stored in the Image Header. Only ever shrinks - upscaling costs Time and
+    /// rarely helps.
+    /// @param image
+    /// @param options
+    /// @return float - in [options.min_scale, 1], 1 if the Page should be left as is
+    inline auto resolutionScale(Pix *image, const ResolutionOptions &options) -> float {
+        float scale = 1.0F;
+
+        if (l_int32 x_height = estimateXHeight(image); x_height > 0) {
+            scale = static_cast<float>(options.target_x_height) / static_cast<float>(x_height);
+        } else if (l_int32 dpi = pixGetXRes(image); dpi > 0) {
+            scale = static_cast<float>(options.target_dpi) / static_cast<float>(dpi);
+        }
+
+        if (scale > options.max_scale) {
+            return 1.0F;
+        }
+        return std::max(scale, options.min_scale);
+    }
+
+    /// @brief Downscale a Page whose Text is larger than Tesseract needs (Phone Photos, HiDPI
+    /// Screenshots). OCR Time grows with the Pixel Count, so halving both Dimensions roughly
+    /// quarters the Recognition Time.
+    /// @param image
+    /// @param options
+    /// @return PixPtr - the scaled Page, or nullptr if image should be used unchanged
+    inline auto normalizeResolution(Pix *image, const ResolutionOptions &options = {}) -> PixPtr {
+        float scale = resolutionScale(image, options);
+        if (scale >= 1.0F) {
+            return nullptr;
+        }
+        return PixPtr(pixScale(image, scale, scale));
+    }
+
+#pragma endregion
+
+} // namespace imgstr
+
+#endif // RESOLUTION_H
@@ -0,0 +1,161 @@
+// segment.h
+#ifndef SEGMENT_H
+#define SEGMENT_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdlib>
+#include <future>
+#include <ktesseract.h>
+#include <optional>
+#include <pix.h>
+#include <preprocess.h>
+#include <string>
+#include <vector>
+
+namespace imgstr {
+
+#pragma region STRIP_SEGMENTATION         /* Horizontal Page Strips for intra-Image Parallelism */
+
+    /// @brief When and how finely a Page is split into Strips - see getTextOCRStrips()
+    struct StripOptions {
+        l_int32     min_height = 2000; // Pages shorter than this are recognized in one piece
+        std::size_t max_strips = 0;    // 0 - one Strip per Engine of the Pool
+        l_int32     min_gap    = 6;    // blank Rows required before a Cut is allowed
+    };
+
+    /// @brief Rows at which a Page can be cut without slicing through a Line of Text.
+    /// A Projection Profile (ink Pixels per Row) of the inkMask() of the Page locates horizontal
+    /// whitespace Gaps, and the Gap closest to each evenly spaced target Row becomes a Cut.
+    /// @param image
+    /// @param max_strips
+    /// @param min_gap
+    /// @return std::vector<l_int32> - ascending Row Boundaries, starting at 0 and ending at the
+    /// Page Height. A Page without usable Gaps yields a single Strip.
+    inline auto findStripCuts(Pix *image, std::size_t max_strips, l_int32 min_gap = 6)
+        -> std::vector<l_int32> {
+        l_int32 width  = pixGetWidth(image);
+        l_int32 height = pixGetHeight(image);
+
+        std::vector<l_int32> cuts {0};
+
+        PixPtr binary(max_strips > 1 ? inkMask(image) : nullptr);
+        Numa  *profile = binary ? pixCountPixelsByRow(binary.get(), nullptr) : nullptr;
+
+        if (profile == nullptr) {
+            cuts.push_back(height);
+            return cuts;
+        }
+
+        // tolerate specks of scanner noise in otherwise blank Rows
+        l_int32 noise = std::max<l_int32>(1, width / 256);
+
+        std::vector<l_int32> gaps; // centre Row of each whitespace Gap
+        l_int32              run = 0;
+
+        for (l_int32 y = 0; y < height; ++y) {
+            l_int32 ink = 0;
+            numaGetIValue(profile, y, &ink);
+
+            if (ink <= noise) {
+                ++run;
+                continue;
+            }
+            if (run >= min_gap && y - run > 0) {
+                gaps.push_back(y - run / 2);
+            }
+            run = 0;
+        }
+        numaDestroy(&profile);
+
+        auto    strips     = static_cast<l_int32>(max_strips);
+        l_int32 min_height = height / (2 * strips);
+
+        for (l_int32 k = 1; k < strips; ++k) {
+            l_int32 target = height * k / strips;
+
+            auto after  = std::lower_bound(gaps.begin(), gaps.end(), target);
+            auto best   = gaps.end();
+            auto better = [&](auto it) {
+                return best == gaps.end() || std::abs(*it - target) < std::abs(*best - target);
+            };
+
+            if (after != gaps.end() && better(after)) {
+                best = after;
+            }
+            if (after != gaps.begin() && better(std::prev(after))) {
+                best = std::prev(after);
+            }
+
+            if (best != gaps.end() && *best - cuts.back() >= min_height &&
+                height - *best >= min_height) {
+                cuts.push_back(*best);
+            }
+        }
+
+        cuts.push_back(height);
+        return cuts;
+    }
+
+    /// @brief Recognize a large Page by cutting it into horizontal Strips at whitespace Gaps,
+    /// running OCR on the Strips concurrently with Engines from the Pool and joining the Text in
+    /// reading Order. Falls back to a single OCR call for Pages below options.min_height and
+    /// inside an OpenMP parallel Region - a Batch already keeps every Engine busy with whole
+    /// Images, so Strips would only queue behind them.
+    /// @param pool
+    /// @param image
+    /// @param img_mode
+    /// @param options
+    /// @param deadline - shared by every Strip
+    /// @return std::string
+    /// @throws OcrTimeoutError if any Strip overruns the Deadline
+    inline auto getTextOCRStrips(TesseractPool             &pool,
+                                 Pix                       *image,
+                                 ImgMode                    img_mode,
+                                 const StripOptions        &options  = {},
+                                 std::optional<OcrDeadline> deadline = std::nullopt)
+        -> std::string {
+        std::size_t max_strips = options.max_strips > 0 ? options.max_strips : pool.maxSize();
+
+        if (pixGetHeight(image) < options.min_height || max_strips < 2 || omp_in_parallel()) {
+            return getTextOCR(pool, image, img_mode, deadline);
+        }
+
+        auto cuts = findStripCuts(image, max_strips, options.min_gap);
+        if (cuts.size() <= 2) {
+            return getTextOCR(pool, image, img_mode, deadline);
+        }
+
+        l_int32 width = pixGetWidth(image);
+
+        std::vector<std::future<std::string>> strips;
+        strips.reserve(cuts.size() - 1);
+
+        for (std::size_t i = 0; i + 1 < cuts.size(); ++i) {
+            Box   *box = boxCreate(0, cuts[i], width, cuts[i + 1] - cuts[i]);
+            PixPtr strip(pixClipRectangle(image, box, nullptr));
+            boxDestroy(&box);
+
+            if (!strip) {
+                throw std::runtime_error("Failed to clip page strip");
+            }
+
+            strips.push_back(std::async(
+                std::launch::async,
+                [&pool, img_mode, deadline, strip = std::move(strip)]() mutable {
+                    return getTextOCR(pool, strip.get(), img_mode, deadline);
+                }));
+        }
+
+        std::string text;
+        for (auto &strip: strips) {
+            text += strip.get();
+        }
+        return text;
+    }
+
+#pragma endregion
+
+} // namespace imgstr
+
+#endif // SEGMENT_H
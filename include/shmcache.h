@@ -0,0 +1,92 @@
+// shmcache.h
+#ifndef SHMCACHE_H
+#define SHMCACHE_H
+
+#include <atomic>
+#include <cstdint>
+#include <digest.h>
+#include <llvm/Support/Error.h>
+#include <memory>
+#include <optional>
+#include <string>
+
+namespace imgstr {
+
+#pragma region SHARED_MEMORY_CACHE        /* Cross Process Digest -> Text Table */
+
+    /// @brief Cache Tier shared by every Process on a Host through a Memory Mapped File.
+    /// A fixed size open addressing Table maps a Digest to the Offset of its Text in an
+    /// append-only Arena behind it. Slots are claimed with a CAS and published with a release
+    /// store, so readers and writers in any Process never take a Lock. Entries are never removed -
+    /// once the Table or the Arena is full further inserts are rejected. Text Space is reserved
+    /// before a Slot is claimed; a Writer that loses the Race for its Digest to another Writer hands
+    /// the Space back only if nobody reserved after it, otherwise those Bytes stay unused.
+    ///
+    /// File Layout : [ShmHeader][Slot x slot_count][Arena]
+    ///
+    /// @code{.cpp}
+    ///   auto shmOrErr = SharedMemoryCache::open("/dev/shm/textract.shm", 1 << 16, 256 << 20);
+    ///   if (!shmOrErr) { handleError(shmOrErr.takeError()); }
+    ///   auto shm = std::move(shmOrErr.get());
+    ///   shm->insert(sha, text);
+    ///   if (auto text = shm->lookup(sha)) { ... }
+    /// @endcode
+    class SharedMemoryCache {
+      public:
+        /// @brief Open the shared File or Create it with the given Geometry. A File created by
+        /// another Process keeps its own Geometry.
+        /// @param path
+        /// @param slot_count - rounded up to a Power of 2
+        /// @param arena_bytes
+        /// @return llvm::Expected<std::unique_ptr<SharedMemoryCache>>
+        static auto open(const std::string &path, uint64_t slot_count, uint64_t arena_bytes)
+            -> llvm::Expected<std::unique_ptr<SharedMemoryCache>>;
+
+        SharedMemoryCache(const SharedMemoryCache &)                     = delete;
+        SharedMemoryCache(SharedMemoryCache &&)                          = delete;
+        auto operator=(const SharedMemoryCache &) -> SharedMemoryCache & = delete;
+        auto operator=(SharedMemoryCache &&) -> SharedMemoryCache      & = delete;
+
+        ~SharedMemoryCache();
+
+        /// @brief Text published for the Digest by any Process
+        /// @param hash
+        /// @return std::optional<std::string>
+        auto lookup(const Sha256Digest &hash) const -> std::optional<std::string>;
+
+        /// @brief Publish the Text for a Digest
+        /// @param hash
+        /// @param text
+        /// @return bool - false if the Table or Arena is full. An existing Entry counts as success.
+        auto insert(const Sha256Digest &hash, const std::string &text) -> bool;
+
+        /// @brief Number of published Entries - approximate under concurrent inserts
+        auto size() const -> uint64_t;
+
+        auto capacity() const -> uint64_t;
+
+        auto path() const -> const std::string & { return file_path; }
+
+      private:
+        struct Header;
+        struct Slot;
+
+        SharedMemoryCache(std::string path, int fd);
+
+        auto map(uint64_t length) -> llvm::Error;
+
+        auto slots() const -> Slot *;
+
+        auto arena() const -> char *;
+
+        std::string file_path;
+        int         fd         = -1;
+        char       *mapped     = nullptr;
+        uint64_t    map_length = 0;
+    };
+
+#pragma endregion
+
+} // namespace imgstr
+
+#endif // SHMCACHE_H
@@ -0,0 +1,56 @@
+// snapshot.h
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+#include <constants.h>
+#include <cstdint>
+#include <digest.h>
+#include <llvm/Support/Error.h>
+#include <string>
+#include <vector>
+
+namespace imgstr {
+
+#pragma region CACHE_SNAPSHOT             /* Point in Time Dump of the in-memory Cache */
+
+    /// @brief A cached Image as written to a Snapshot - the KImage fields of src/schema.capnp
+    /// plus the Cache specific State (compressed Text, processing and write Metadata)
+    struct SnapshotEntry {
+        Sha256Digest hash;
+        std::string  uri;
+        std::string  text; // as held by the Cache - zlib compressed if text_compressed
+        std::string  time_processed;
+        std::string  fuzzhash;
+        std::string  output_path;
+        std::string  write_timestamp;
+        uint64_t     text_size       = 0; // uncompressed Text Size
+        uint64_t     image_size      = 0;
+        bool         text_compressed = false;
+        bool         output_written  = false;
+        bool         skipped         = false; // blank Image, OCR never ran
+        ISOLang      lang            = ISOLang::en;
+        OcrProfile   profile         = OcrProfile::balanced; // Key is hash + lang + profile
+    };
+
+    /// @brief Write every Entry to a single Snapshot File. The File is written next to the
+    /// target and renamed over it, so a crash mid-export leaves the previous Snapshot intact.
+    ///
+    /// File Layout : [SnapshotHeader][EntryHeader|hash|uri|text|time|fuzzhash|output|ts]...
+    ///
+    /// @param path
+    /// @param entries
+    /// @return llvm::Error
+    auto writeSnapshot(const std::string &path, const std::vector<SnapshotEntry> &entries)
+        -> llvm::Error;
+
+    /// @brief Memory Map a Snapshot File and decode its Entries. The whole File is checksummed
+    /// up front - a truncated or corrupt Snapshot is rejected rather than partially loaded.
+    /// @param path
+    /// @return llvm::Expected<std::vector<SnapshotEntry>>
+    auto readSnapshot(const std::string &path) -> llvm::Expected<std::vector<SnapshotEntry>>;
+
+#pragma endregion
+
+} // namespace imgstr
+
+#endif // SNAPSHOT_H
@@ -0,0 +1,101 @@
+// store.h
+#ifndef STORE_H
+#define STORE_H
+
+#include <cstdint>
+#include <digest.h>
+#include <folly/SharedMutex.h>
+#include <llvm/ADT/StringRef.h>
+#include <llvm/Support/Error.h>
+#include <memory>
+#include <optional>
+#include <string>
+#include <unordered_map>
+
+namespace imgstr {
+
+#pragma region PERSISTENT_STORE           /* Append-only On-Disk Image Store */
+
+    /// @brief A Processed Image as persisted on Disk. Mirrors the KImage struct in
+    /// src/schema.capnp (uri, size, hash, text, fuzzhash).
+    struct StoreRecord {
+        Sha256Digest hash;
+        std::string  uri;
+        std::string  text;
+        std::string  fuzzhash;
+        uint64_t     image_size = 0;
+    };
+
+    /// @brief Persistent Cache Tier backed by an Append-only, Memory Mapped File.
+    /// Records present when the Store is opened are served straight from the Mapping, Records
+    /// appended afterwards are read back with pread(). A torn trailing Record (crash mid-append) is
+    /// detected through its checksum and truncated away on open.
+    ///
+    /// File Layout : [FileHeader][RecordHeader|hash|uri|text|fuzzhash]...
+    ///
+    /// @code{.cpp}
+    ///   auto storeOrErr = ImageStore::open("/var/cache/textract.kimg");
+    ///   if (!storeOrErr) { handleError(storeOrErr.takeError()); }
+    ///   auto store = std::move(storeOrErr.get());
+    ///   store->append({sha, path, text, "", size});
+    ///   auto record = store->lookup(sha);
+    /// @endcode
+    class ImageStore {
+      public:
+        /// @brief Open or Create a Store at the Path and Index all valid Records. The File is held
+        /// with an exclusive flock() until the Store is destroyed.
+        /// @param path
+        /// @return llvm::Expected<std::unique_ptr<ImageStore>> - an Error if another Processor or
+        /// Process has the Store open, or the File is not a Store
+        static auto open(const std::string &path) -> llvm::Expected<std::unique_ptr<ImageStore>>;
+
+        ImageStore(const ImageStore &)                     = delete;
+        ImageStore(ImageStore &&)                          = delete;
+        auto operator=(const ImageStore &) -> ImageStore & = delete;
+        auto operator=(ImageStore &&) -> ImageStore      & = delete;
+
+        ~ImageStore();
+
+        /// @brief Retrieve the latest Record stored for a Hash
+        /// @param hash
+        /// @return std::optional<StoreRecord>
+        auto lookup(const Sha256Digest &hash) const -> std::optional<StoreRecord>;
+
+        /// @brief Check if a Record exists for the Hash without reading it
+        auto contains(const Sha256Digest &hash) const -> bool;
+
+        /// @brief Append a Record - written with a single write() so concurrent readers never
+        /// observe a partial Record
+        /// @param record
+        /// @return llvm::Error
+        auto append(const StoreRecord &record) -> llvm::Error;
+
+        /// @brief Number of unique Hashes in the Store
+        auto size() const -> size_t;
+
+        auto path() const -> const std::string & { return file_path; }
+
+      private:
+        ImageStore(std::string path, int fd);
+
+        auto load() -> llvm::Error;
+
+        auto readAt(uint64_t offset, size_t length, char *dst) const -> bool;
+
+        auto readRecord(uint64_t offset) const -> std::optional<StoreRecord>;
+
+        std::string                                              file_path;
+        int                                                      fd          = -1;
+        const char                                              *mapped      = nullptr;
+        uint64_t                                                 map_length  = 0;
+        uint64_t                                                 mapped_size = 0;
+        uint64_t                                                 end_offset  = 0;
+        std::unordered_map<Sha256Digest, uint64_t, DigestHasher> index;
+        mutable folly::SharedMutex                               mutex;
+    };
+
+#pragma endregion
+
+} // namespace imgstr
+
+#endif // STORE_H
@@ -1,17 +1,34 @@
 #ifndef TEXTRACT_H
 #define TEXTRACT_H
 
+#include <adaptive.h>
+#include <array>
+#include <blank.h>
+#include <cache.h>
+#include <chrono>
+#include <compress.h>
 #include <constants.h>
 #include <conversion.h>
 #include <crypto.h>
-#include <folly/AtomicUnorderedMap.h>
 #include <folly/SharedMutex.h>
 #include <fs.h>
 #include <future>
+#include <imghash.h>
 #include <ktesseract.h>
+#include <layout.h>
 #include <logger.h>
+#include <mutex>
 #include <omp.h>
+#include <pathindex.h>
+#include <preprocess.h>
+#include <render.h>
+#include <resolution.h>
+#include <segment.h>
+#include <shmcache.h>
+#include <snapshot.h>
+#include <store.h>
 #include <util.h>
+#include <words.h>
 
 namespace imgstr {
 
@@ -62,7 +79,8 @@ namespace imgstr {
      * Provides an efficient, high performance implementation
      * of Text Extraction from Images.
      * Supports Parallelized Image Processing and maintains an in-memory cache.
-     * Uses an Atomic Unordered Map for Safe Wait-Free parallel access
+     * The cache is bounded by an entry count and a byte budget, evicting with CLOCK,
+     * and serves lookups wait-free so long running processors keep a steady footprint.
      * Cache retrieval logic is determined by the SHA256 hash of the Image bytes
      * The SHA256 Byte Hash enables duplicate images to not be processed even if
      * the file names or paths differ.
@@ -78,28 +96,37 @@ namespace imgstr {
     };
 
     struct Image {
-        std::string path;
-        std::string text_content;
-        std::string image_sha256;
-        std::string time_processed;
-        std::string content_fuzzhash;
-        std::size_t text_size;
-        std::size_t image_size;
+        std::string  path;
+        std::string  text_content;
+        Sha256Digest image_sha256;
+        std::string  time_processed;
+        std::string  content_fuzzhash;
+        std::size_t  text_size;
+        std::size_t  image_size;
+        bool         text_compressed = false;
+        bool         skipped         = false; // classified blank - OCR never ran
+        ISOLang      lang            = ISOLang::en;
+        OcrProfile   profile         = OcrProfile::balanced;
+        OcrWords     words; // with enableWordResults() - not persisted, Store Hits have none
 
         mutable WriteMetadata write_info;
 
         mutable std::unique_ptr<folly::SharedMutex> mutex;
 
-        Image(std::string        img_hash,
+        Image(const Sha256Digest &img_hash,
               std::string        path,
               const std::string &text_content,
-              size_t             image_size = 0)
+              size_t             image_size = 0,
+              ISOLang            lang       = ISOLang::en,
+              OcrProfile         profile    = OcrProfile::balanced)
             : mutex(nullptr),
               path(std::move(path)),
               image_size(image_size),
+              lang(lang),
+              profile(profile),
               text_size(text_content.size()),
               text_content(text_content),
-              image_sha256(std::move(img_hash)),
+              image_sha256(img_hash),
               time_processed(getCurrentTimestamp()) {}
 
         void updateWriteInfo(const std::string &output_path,
@@ -123,6 +150,32 @@ namespace imgstr {
             return write_info;
         }
 
+        /// @brief Text of the Image - decompressed on access if the Cache holds it compressed
+        std::string text() const {
+            return text_compressed ? decompressText(text_content, text_size) : text_content;
+        }
+
+        /// @brief Replace text_content with its zlib Compression if that saves space
+        void compressTextContent() {
+            if (text_compressed || text_content.size() < MIN_COMPRESSIBLE_TEXT) {
+                return;
+            }
+
+            std::string packed = compressText(text_content);
+            if (packed.size() < text_content.size()) {
+                text_content    = std::move(packed);
+                text_compressed = true;
+            }
+        }
+
+        /// @brief Approximate Bytes held by the Image - used to account the Cache Byte Budget
+        std::size_t footprint() const {
+            return sizeof(Image) + path.capacity() + text_content.capacity() +
+                   time_processed.capacity() + content_fuzzhash.capacity() +
+                   write_info.output_path.capacity() + write_info.write_timestamp.capacity() +
+                   words.footprint();
+        }
+
         std::string getName() const {
             auto lastSlash = path.find_last_of("/\\");
             if (lastSlash != std::string::npos) {
@@ -132,6 +185,58 @@ namespace imgstr {
         }
     };
 
+    /// @brief Default Byte Budget of the in-memory Cache
+    static constexpr std::size_t DEFAULT_CACHE_BYTES = 256UL * 1024 * 1024;
+
+    using ImagePtr = std::shared_ptr<const Image>;
+
+    /// @brief Point in Time Snapshot of the Cache Counters - see ImgProcessor::getCacheStats()
+    struct CacheStats {
+        uint64_t    hits           = 0; // exact Hash found in the in-memory Cache
+        uint64_t    stat_hits      = 0; // resolved through the stat() Path Index
+        uint64_t    store_hits     = 0; // loaded from the Persistent Store
+        uint64_t    shared_hits    = 0; // published by another Process in the Shared Cache
+        uint64_t    near_hits      = 0; // Text reused from a perceptual near Duplicate
+        uint64_t    in_flight_hits = 0; // waited on a concurrent OCR of the same Bytes
+        uint64_t    misses         = 0; // OCR was run
+        uint64_t    skipped        = 0; // blank Images cached without OCR
+        uint64_t    first_pass     = 0; // adaptive OCR - accepted after the cheap Pass
+        uint64_t    second_pass    = 0; // adaptive OCR - re-read with the requested Profile
+        uint64_t    regions_rerun  = 0; // adaptive OCR - Blocks re-read in second Passes
+        uint64_t    timeouts       = 0; // OCR cancelled at the Deadline - see enableOcrDeadline()
+        uint64_t    pages          = 0; // Pages of multi-page Documents, each cached on its own
+        uint64_t    inserts        = 0;
+        uint64_t    evictions      = 0;
+        uint64_t    duplicates     = 0; // Inputs whose SHA256 matched an Image already seen
+        std::size_t entries        = 0;
+        std::size_t capacity       = 0;
+        std::size_t bytes_stored   = 0;
+        std::size_t byte_budget    = 0;
+        double      ocr_ms         = 0.0; // total Time spent in OCR
+        double      time_saved_ms  = 0.0; // Hits x average OCR Latency
+
+        auto totalHits() const -> uint64_t {
+            return hits + stat_hits + store_hits + shared_hits + near_hits + in_flight_hits;
+        }
+
+        auto hitRatio() const -> double {
+            uint64_t lookups = totalHits() + misses + skipped;
+            return lookups == 0 ? 0.0 : static_cast<double>(totalHits()) / lookups;
+        }
+    };
+
+    /// @brief Which Budget a Recognition runs under - see enableOcrDeadline()
+    enum class OcrLane { normal, slow };
+
+    /// @brief Per Image OCR Budgets. Images that overrun the normal Budget are cancelled so one
+    /// pathological Image cannot stall the tail of a parallel Batch; with slow_lane they are
+    /// retried once after the Batch under slow_budget.
+    struct DeadlineOptions {
+        std::chrono::milliseconds budget {30000};
+        bool                      slow_lane = true;
+        std::chrono::milliseconds slow_budget {0}; // 0 - no Deadline in the slow Lane
+    };
+
     class ImgProcessor {
       private:
         ImgMode                                             img_mode;
@@ -140,10 +245,52 @@ namespace imgstr {
         std::vector<std::string>                            queued;
         std::unordered_set<std::string>                     files;
         std::unordered_set<std::string>                     processed;
-        folly::AtomicUnorderedInsertMap<std::string, Image> cache;
+        ClockCache<Sha256Digest, Image, DigestHasher>       cache;
         std::atomic<double>                                 totalProcessingTime {0.0};
         std::atomic<int>                                    processedImagesCount {0};
         std::unique_ptr<AsyncLogger>                        logger;
+        LanguagePools                                       engines {1};
+        std::unique_ptr<ImageStore>                         store;
+        std::unique_ptr<PathIndex>                          path_index;
+        std::unique_ptr<NearDuplicateIndex>                 near_index;
+        std::unique_ptr<SharedMemoryCache>                  shared_cache;
+        SingleFlight<Sha256Digest, ImagePtr, DigestHasher>  in_flight;
+        bool                                                compress_text = false;
+        std::string                                         snapshot_path;
+        bool                                                prewarm_engines = false;
+        std::optional<StripOptions>                         strip_ocr;
+        std::optional<ResolutionOptions>                    resolution;
+        PreprocessPipeline                                  preprocessing;
+        std::optional<BlankOptions>                         blank_detection;
+        std::optional<LayoutOptions>                        layout_filter;
+        OcrProfile                                          ocr_profile = OcrProfile::balanced;
+        std::optional<AdaptiveOptions>                      adaptive;
+        std::optional<DeadlineOptions>                      deadlines;
+        bool                                                word_results = false;
+        std::unordered_set<std::string>                     timed_out;
+        std::mutex                                          timed_out_mutex;
+
+        /// @brief Lock-free Counters behind CacheStats - relaxed, they are only ever summed
+        struct CacheCounters {
+            std::atomic<uint64_t> hits {0};
+            std::atomic<uint64_t> stat_hits {0};
+            std::atomic<uint64_t> store_hits {0};
+            std::atomic<uint64_t> shared_hits {0};
+            std::atomic<uint64_t> near_hits {0};
+            std::atomic<uint64_t> in_flight_hits {0};
+            std::atomic<uint64_t> misses {0};
+            std::atomic<uint64_t> skipped {0};
+            std::atomic<uint64_t> first_pass {0};
+            std::atomic<uint64_t> second_pass {0};
+            std::atomic<uint64_t> regions_rerun {0};
+            std::atomic<uint64_t> timeouts {0};
+            std::atomic<uint64_t> pages {0};
+            std::atomic<uint64_t> ocr_us {0};
+        } counters;
+
+        static void bump(std::atomic<uint64_t> &counter, uint64_t by = 1) {
+            counter.fetch_add(by, std::memory_order_relaxed);
+        }
 
         static constexpr char path_separator = '/';
 #ifdef _WIN32
@@ -156,62 +303,630 @@ namespace imgstr {
          * Reads File Bytes, checks Hash of Image, pulls from the Cache if it exists,
          or sends Bytes to Tesseract to process to Text.
          * @param file
-         * @return std::optional<std::reference_wrapper<const Image>>
+         * @param lang
+         * @param requested - Profile for this Call, the Processor's Profile if not given
+         * @param lane - Budget of the Recognition if enableOcrDeadline() is set
+         * @param with_words - keep the Words if OCR runs, as with enableWordResults()
+         * @return ImagePtr - nullptr if the Image could not be processed or timed out
 
          */
 
-        std::optional<std::reference_wrapper<const Image>>
-            processImageFile(const std::string &file) {
+        ImagePtr processImageFile(const std::string        &file,
+                                  ISOLang                   lang       = ISOLang::en,
+                                  std::optional<OcrProfile> requested  = std::nullopt,
+                                  OcrLane                   lane       = OcrLane::normal,
+                                  bool                      with_words = false) {
 #ifdef _DEBUGAPP
             logger->log() << LIGHT_GREY << "processImageFile() for " << END << file;
 #endif
 
             try {
-                auto start = getStartTime();
+                auto       start   = getStartTime();
+                OcrProfile profile = requested.value_or(ocr_profile);
+
+                std::optional<FileIdentity> identity;
+
+                if (path_index) {
+                    identity = FileIdentity::of(file);
+
+                    auto img_from_stat = getFromPathIndexIfExists(identity, file, lang, profile);
+                    if (img_from_stat) {
+                        addProcessingTime(totalProcessingTime, getDuration(start));
+                        bump(counters.stat_hits);
+
+                        printCacheHit(file);
+
+                        return img_from_stat;
+                    }
+                }
 
                 std::vector<unsigned char> data = readBytesFromFile(file);
 
-                std::string img_hash = computeSHA256(data);
+                Sha256Digest img_hash = computeSHA256(data);
 
-                auto img_from_cache = getFromCacheIfExists(img_hash);
+                indexFileIdentity(identity, file, img_hash);
+
+                Sha256Digest key = cacheKey(img_hash, lang, profile);
+
+                auto img_from_cache = getFromCacheIfExists(key);
 
                 if (img_from_cache) {
                     addProcessingTime(totalProcessingTime, getDuration(start));
+                    bump(counters.hits);
 
                     printCacheHit(file);
 
-                    return std::cref(img_from_cache->get());
+                    return img_from_cache;
                 }
-                std::string img_text = getTextOCR(data, "eng", img_mode);
 
-                addProcessingTime(totalProcessingTime, getDuration(start));
+                auto img_from_store = getFromStoreIfExists(img_hash, file, lang, profile);
 
-                Image image(img_hash, file, img_text, data.size());
+                if (img_from_store) {
+                    addProcessingTime(totalProcessingTime, getDuration(start));
+                    bump(counters.store_hits);
+
+                    printStoreHit(file);
+
+                    return img_from_store;
+                }
+
+                auto img_from_shared =
+                    getFromSharedCacheIfExists(img_hash, file, lang, profile, data.size());
+
+                if (img_from_shared) {
+                    addProcessingTime(totalProcessingTime, getDuration(start));
+                    bump(counters.shared_hits);
+
+                    printSharedCacheHit(file);
+
+                    return img_from_shared;
+                }
 
-                const auto &cachedImage = cache.emplace(img_hash, std::move(image)).first->second;
+                auto [image, shared] = in_flight.run(key, [&] {
+                    return recognizeImage(
+                        img_hash, file, lang, profile, data, laneBudget(lane), with_words);
+                });
+
+                addProcessingTime(totalProcessingTime, getDuration(start));
+
+                if (shared) {
+                    bump(counters.in_flight_hits);
+                    printInFlightHit(file);
+                }
 
                 processed.insert(file);
 
-                return std::cref(cachedImage);
+                return image;
+
+            } catch (const OcrTimeoutError &e) {
+                bump(counters.timeouts);
+                markTimedOut(file);
+                printOcrTimeout(file, lane);
+                return nullptr;
 
             } catch (const std::exception &e) {
                 printFileProcessingFailure(file, e.what());
+                return nullptr;
+            }
+        }
+
+        /// @brief OCR Budget of a Lane - std::nullopt if Recognition may run unbounded
+        auto laneBudget(OcrLane lane) const -> std::optional<std::chrono::milliseconds> {
+            if (!deadlines) {
+                return std::nullopt;
+            }
+
+            auto budget = lane == OcrLane::slow ? deadlines->slow_budget : deadlines->budget;
+            if (budget.count() <= 0) {
                 return std::nullopt;
             }
+            return budget;
         }
 
-        auto getImageOrProcess(const std::string &file_path, ISOLang lang = ISOLang::en)
-            -> std::optional<std::reference_wrapper<const Image>> {
-            return processImageFile(file_path);
+        void markTimedOut(const std::string &file) {
+            std::lock_guard<std::mutex> lock(timed_out_mutex);
+            timed_out.insert(file);
         }
 
-        auto getFromCacheIfExists(const std::string &img_sha)
-            -> std::optional<std::reference_wrapper<const Image>> {
-            auto img_from_cache = cache.find(img_sha);
-            if (img_from_cache != cache.end()) {
-                return std::cref(img_from_cache->second);
+        auto isTimedOut(const std::string &file) -> bool {
+            std::lock_guard<std::mutex> lock(timed_out_mutex);
+            return timed_out.count(file) > 0;
+        }
+
+        /// @brief Decode and OCR the Image Bytes. Runs at most once at a time per Cache Key -
+        /// concurrent callers with the same Bytes and Language wait on this call through in_flight.
+        /// @param img_hash
+        /// @param file
+        /// @param lang
+        /// @param profile
+        /// @param data
+        /// @param budget - OCR Time allowed from the start of Recognition, unbounded if not given
+        /// @param with_words - keep the Words even without enableWordResults()
+        /// @return ImagePtr
+        /// @throws OcrTimeoutError if Recognition overran the Budget - nothing is cached
+        auto recognizeImage(const Sha256Digest                      &img_hash,
+                            const std::string                       &file,
+                            ISOLang                                  lang,
+                            OcrProfile                               profile,
+                            const std::vector<unsigned char>        &data,
+                            std::optional<std::chrono::milliseconds> budget     = std::nullopt,
+                            bool                                     with_words = false)
+            -> ImagePtr {
+            // a flight for the same Key may have landed between our Cache miss and this call
+            if (auto img_from_cache = getFromCacheIfExists(cacheKey(img_hash, lang, profile))) {
+                bump(counters.hits);
+                return img_from_cache;
             }
-            return std::nullopt;
+
+            std::vector<PixPtr> pages = decodePages(data);
+
+            if (pages.size() > 1) {
+                return recognizeDocument(
+                    img_hash, file, lang, profile, data.size(), pages, budget, with_words);
+            }
+
+            Pix *pix = pages.front().get();
+
+            return recognizeDecoded(
+                img_hash, file, pix, lang, profile, data.size(), budget, with_words);
+        }
+
+        /// @brief Blank Check, near Duplicate Lookup and OCR of a decoded Image or Page - the
+        /// Result is cached, persisted and shared under img_hash
+        /// @throws OcrTimeoutError if Recognition overran the Budget - nothing is cached
+        auto recognizeDecoded(const Sha256Digest                      &img_hash,
+                              const std::string                       &file,
+                              Pix                                     *pix,
+                              ISOLang                                  lang,
+                              OcrProfile                               profile,
+                              std::size_t                              image_size,
+                              std::optional<std::chrono::milliseconds> budget,
+                              bool                                     with_words) -> ImagePtr {
+            if (blank_detection && isBlankImage(pix, *blank_detection)) {
+                bump(counters.skipped);
+                return cacheSkippedImage(img_hash, file, lang, profile, image_size);
+            }
+
+            auto fuzzhash = near_index ? computeFuzzHash(pix) : std::nullopt;
+
+            auto img_from_near =
+                getFromNearDuplicateIfExists(fuzzhash, img_hash, file, lang, profile, image_size);
+
+            if (img_from_near) {
+                bump(counters.near_hits);
+                printNearDuplicateHit(file);
+
+                return img_from_near;
+            }
+
+            std::optional<OcrDeadline> deadline;
+            if (budget) {
+                deadline = std::chrono::steady_clock::now() + *budget;
+            }
+
+            auto        ocr_start = getStartTime();
+            OcrWords    words;
+            std::string img_text  = recognizePix(
+                pix, lang, profile, deadline, word_results || with_words ? &words : nullptr);
+
+            bump(counters.misses);
+            bump(counters.ocr_us, static_cast<uint64_t>(getDuration(ocr_start) * 1000));
+
+            Image image(img_hash, file, img_text, image_size, lang, profile);
+            image.words = std::move(words);
+
+            if (fuzzhash) {
+                image.content_fuzzhash = fuzzhash->toString();
+                near_index->insert(
+                    *fuzzhash, cacheKey(img_hash, lang, profile), nearDuplicateTag(lang, profile));
+            }
+
+            auto cachedImage = cacheImage(std::move(image));
+
+            persistImage(*cachedImage);
+            shareImage(*cachedImage);
+
+            return cachedImage;
+        }
+
+        /// @brief OCR every Page of a multi-page Document as an independent Task on the Engine
+        /// Pool. Pages are keyed by the Digest of their Pixels, so a Page shared with another
+        /// Document - a Cover Sheet, a repeated Form - is a Cache Hit. The Document Text is the
+        /// Page Texts in Page Order separated by Form Feeds, as Tesseract writes them. The
+        /// Budget applies to each Page; Words are kept on the Pages only. Pages are recognized by
+        /// at most one OpenMP Thread per pooled Engine - inside a Batch the Region is nested and
+        /// the Pages are read one after another on the calling Thread.
+        /// @throws OcrTimeoutError if any Page overran the Budget - the Document is not cached
+        auto recognizeDocument(const Sha256Digest                      &img_hash,
+                               const std::string                       &file,
+                               ISOLang                                  lang,
+                               OcrProfile                               profile,
+                               std::size_t                              image_size,
+                               const std::vector<PixPtr>               &pages,
+                               std::optional<std::chrono::milliseconds> budget,
+                               bool                                     with_words) -> ImagePtr {
+            std::size_t workers = engines.get(isoToTesseractLang(lang), profile).maxSize();
+            workers             = std::clamp<std::size_t>(workers, 1, pages.size());
+
+            std::vector<ImagePtr> results(pages.size());
+            std::exception_ptr    failure;
+            std::mutex            failure_mutex;
+
+#pragma omp parallel for num_threads(static_cast<int>(workers)) schedule(dynamic)
+            for (std::size_t i = 0; i < pages.size(); ++i) {
+                try {
+                    auto page_file = fmtstr("{0}[page {1}]", file, i + 1);
+                    results[i]     = recognizePage(
+                        pages[i].get(), page_file, lang, profile, budget, with_words);
+                } catch (...) {
+                    // Exceptions must not leave the OpenMP Region - the first is rethrown below
+                    std::lock_guard<std::mutex> lock(failure_mutex);
+                    if (!failure) {
+                        failure = std::current_exception();
+                    }
+                }
+            }
+
+            if (failure) {
+                std::rethrow_exception(failure);
+            }
+
+            std::string text;
+            for (std::size_t i = 0; i < results.size(); ++i) {
+                if (i > 0) {
+                    text += '\f';
+                }
+                text += results[i]->text();
+            }
+
+            bump(counters.pages, pages.size());
+
+            auto cachedImage = cacheImage(Image(img_hash, file, text, image_size, lang, profile));
+
+            persistImage(*cachedImage);
+            shareImage(*cachedImage);
+
+            return cachedImage;
+        }
+
+        /// @brief Cached or recognized Text of one Page of a Document
+        auto recognizePage(Pix                                     *page,
+                           const std::string                       &page_file,
+                           ISOLang                                  lang,
+                           OcrProfile                               profile,
+                           std::optional<std::chrono::milliseconds> budget,
+                           bool                                     with_words) -> ImagePtr {
+            Sha256Digest page_hash = pageDigest(page);
+            Sha256Digest key       = cacheKey(page_hash, lang, profile);
+
+            if (auto page_from_cache = getFromCacheIfExists(key)) {
+                bump(counters.hits);
+                return page_from_cache;
+            }
+
+            if (auto page_from_store = getFromStoreIfExists(page_hash, page_file, lang, profile)) {
+                bump(counters.store_hits);
+                return page_from_store;
+            }
+
+            auto [image, shared] = in_flight.run(key, [&] {
+                return recognizeDecoded(
+                    page_hash, page_file, page, lang, profile, 0, budget, with_words);
+            });
+
+            if (shared) {
+                bump(counters.in_flight_hits);
+            }
+            return image;
+        }
+
+        /// @brief SHA256 of the decoded Pixels of a Page - identical Pages share it even when the
+        /// Files holding them are encoded differently. Hashed on a Copy whose Pad Bits - past the
+        /// Width in the last Word of each Row, left undefined by the Decoders - are cleared.
+        static auto pageDigest(Pix *page) -> Sha256Digest {
+            PixPtr copy;
+            if (pixGetColormap(page) != nullptr) {
+                copy.reset(pixRemoveColormap(page, REMOVE_CMAP_BASED_ON_SRC));
+            }
+            if (!copy) {
+                copy.reset(pixCopy(nullptr, page));
+            }
+            if (!copy) {
+                throw std::runtime_error("Failed to copy page");
+            }
+            page = copy.get();
+            pixSetPadBits(page, 0);
+
+            std::array<l_int32, 3> header {
+                pixGetWidth(page), pixGetHeight(page), pixGetDepth(page)};
+
+            const auto *head   = reinterpret_cast<const unsigned char *>(header.data());
+            const auto *raster = reinterpret_cast<const unsigned char *>(pixGetData(page));
+            auto        size   = static_cast<std::size_t>(pixGetWpl(page)) * 4 * header[1];
+
+            std::vector<unsigned char> bytes(head, head + sizeof(header));
+            bytes.insert(bytes.end(), raster, raster + size);
+
+            return computeSHA256(bytes);
+        }
+
+        /// @brief Run OCR on a decoded Image with a pooled Engine for the Language - downscaled
+        /// by enableResolutionNormalization(), passed through the setPreprocessing() Pipeline,
+        /// then restricted to Text Regions by enableLayoutFilter(), read in two Passes by
+        /// enableAdaptiveOCR() or split into parallel Strips by enableStripOCR(). With words the
+        /// Image is read in a single full Pass instead, without Preprocessing Steps that move
+        /// Pixels such as deskew(), and its Words are collected alongside.
+        /// @throws OcrTimeoutError if a deadline is given and passes before the Text is read
+        auto recognizePix(Pix                       *pix,
+                          ISOLang                    lang,
+                          OcrProfile                 profile,
+                          std::optional<OcrDeadline> deadline = std::nullopt,
+                          OcrWords                  *words    = nullptr) -> std::string {
+            TesseractPool &pool = engines.get(isoToTesseractLang(lang), profile);
+
+            l_int32 width  = pixGetWidth(pix);
+            l_int32 height = pixGetHeight(pix);
+
+            PixPtr scaled = resolution ? normalizeResolution(pix, *resolution) : nullptr;
+            if (scaled) {
+                pix = scaled.get();
+            }
+
+            // Word Boxes are mapped back by Scale only - Steps that rotate the Page are left out
+            PixPtr prepared = preprocessing.run(pix, words != nullptr);
+            if (prepared) {
+                pix = prepared.get();
+            }
+
+            if (words) {
+                auto result = getTextOCRWords(pool, pix, img_mode, deadline);
+
+                *words = std::move(result.words);
+                if (pixGetWidth(pix) != width || pixGetHeight(pix) != height) {
+                    words->scale(static_cast<float>(width) / pixGetWidth(pix),
+                                 static_cast<float>(height) / pixGetHeight(pix));
+                    words->page_width  = width;
+                    words->page_height = height;
+                }
+                return result.text;
+            }
+
+            if (layout_filter && img_mode == ImgMode::image) {
+                return getTextOCRTextRegions(pool, pix, *layout_filter, deadline);
+            }
+
+            if (adaptive && profile != adaptive->first_pass) {
+                TesseractPool &first = engines.get(isoToTesseractLang(lang), adaptive->first_pass);
+
+                auto result =
+                    getTextOCRAdaptive(first, pool, pix, img_mode, *adaptive, deadline);
+
+                bump(result.second_pass ? counters.second_pass : counters.first_pass);
+                bump(counters.regions_rerun, result.regions_rerun);
+
+                return result.text;
+            }
+
+            if (strip_ocr) {
+                return getTextOCRStrips(pool, pix, img_mode, *strip_ocr, deadline);
+            }
+
+            return getTextOCR(pool, pix, img_mode, deadline);
+        }
+
+        auto getImageOrProcess(const std::string        &file_path,
+                               ISOLang                   lang       = ISOLang::en,
+                               std::optional<OcrProfile> profile    = std::nullopt,
+                               OcrLane                   lane       = OcrLane::normal,
+                               bool                      with_words = false) -> ImagePtr {
+            return processImageFile(file_path, lang, profile, lane, with_words);
+        }
+
+        /// @brief Key of the Image Bytes recognized in a Language under a Profile - the Cache,
+        /// Persistent Store, Shared Cache, Near Duplicate Index and in_flight are keyed by it, the
+        /// Path Index by the plain Content Digest
+        static auto cacheKey(const Sha256Digest &img_hash,
+                             ISOLang             lang,
+                             OcrProfile          profile = OcrProfile::balanced) -> Sha256Digest {
+            return languageKey(img_hash, engineKey(isoToTesseractLang(lang), profile));
+        }
+
+        /// @brief NearDuplicateIndex Tag - a Query only matches Text read in the same Language
+        /// under the same Profile
+        static auto nearDuplicateTag(ISOLang lang, OcrProfile profile) -> uint32_t {
+            return static_cast<uint32_t>(lang) << 8 | static_cast<uint32_t>(profile);
+        }
+
+        auto getFromCacheIfExists(const Sha256Digest &key) -> ImagePtr { return cache.find(key); }
+
+        /// @brief Resolve an unchanged File straight to its Image through the stat() Identity -
+        /// skipping the read and SHA256 of the File
+        /// @param identity
+        /// @param file
+        /// @param lang
+        /// @param profile
+        /// @return ImagePtr - nullptr if the Identity is unknown or its Image is no longer cached
+        auto getFromPathIndexIfExists(const std::optional<FileIdentity> &identity,
+                                      const std::string                 &file,
+                                      ISOLang                            lang,
+                                      OcrProfile                         profile) -> ImagePtr {
+            if (!identity) {
+                return nullptr;
+            }
+
+            auto digest = path_index->find(*identity);
+            if (!digest) {
+                return nullptr;
+            }
+
+            if (auto image = getFromCacheIfExists(cacheKey(*digest, lang, profile))) {
+                return image;
+            }
+
+            return getFromStoreIfExists(*digest, file, lang, profile);
+        }
+
+        /// @brief Record the Identity -> Digest mapping only if the File did not change while it
+        /// was being read, otherwise a stale Identity could map to the new Bytes
+        void indexFileIdentity(const std::optional<FileIdentity> &identity,
+                               const std::string                 &file,
+                               const Sha256Digest                &img_hash) {
+            if (identity && FileIdentity::of(file) == identity) {
+                path_index->insert(*identity, img_hash);
+            }
+        }
+
+        /// @brief Cache a blank Image with empty Text so later Copies are plain Cache Hits. The
+        /// skipped Flag survives Snapshots, the Store and Shared Cache only keep the empty Text.
+        auto cacheSkippedImage(const Sha256Digest &img_hash,
+                               const std::string  &file,
+                               ISOLang             lang,
+                               OcrProfile          profile,
+                               std::size_t         image_size) -> ImagePtr {
+            Image image(img_hash, file, "", image_size, lang, profile);
+            image.skipped = true;
+
+            auto cachedImage = cacheImage(std::move(image));
+
+            persistImage(*cachedImage);
+            shareImage(*cachedImage);
+
+            return cachedImage;
+        }
+
+        auto cacheImage(Image &&image) -> ImagePtr {
+            if (compress_text) {
+                image.compressTextContent();
+            }
+
+            auto bytes = image.footprint();
+            auto key   = cacheKey(image.image_sha256, image.lang, image.profile);
+            return cache.insert(key, std::move(image), bytes);
+        }
+
+        /// @brief Consult the Persistent Store - a Hit is promoted into the in-memory Cache so the
+        /// Store is read at most once per Key for the lifetime of the Processor
+        /// @param img_sha
+        /// @param file
+        /// @param lang
+        /// @param profile
+        /// @return ImagePtr - nullptr if the Store is disabled or does not hold the Key
+        auto getFromStoreIfExists(const Sha256Digest &img_sha,
+                                  const std::string  &file,
+                                  ISOLang             lang,
+                                  OcrProfile          profile) -> ImagePtr {
+            if (!store) {
+                return nullptr;
+            }
+
+            auto record = store->lookup(cacheKey(img_sha, lang, profile));
+            if (!record) {
+                return nullptr;
+            }
+
+            Image image(img_sha, file, record->text, record->image_size, lang, profile);
+            image.content_fuzzhash = std::move(record->fuzzhash);
+
+            if (near_index) {
+                if (auto fuzzhash = FuzzHash::fromString(image.content_fuzzhash)) {
+                    near_index->insert(*fuzzhash,
+                                       cacheKey(img_sha, lang, profile),
+                                       nearDuplicateTag(lang, profile));
+                }
+            }
+
+            return cacheImage(std::move(image));
+        }
+
+        /// @brief Reuse the Text of a perceptually identical Image (re-encoded, rescaled or with
+        /// different metadata) instead of running OCR. Only Text recognized in the same Language
+        /// is reused. The new Bytes are cached under their own Key so the next exact copy is a
+        /// plain Cache Hit.
+        /// @param fuzzhash
+        /// @param img_sha
+        /// @param file
+        /// @param lang
+        /// @param profile
+        /// @param image_size
+        /// @return ImagePtr - nullptr if no near Duplicate is cached
+        auto getFromNearDuplicateIfExists(const std::optional<FuzzHash> &fuzzhash,
+                                          const Sha256Digest            &img_sha,
+                                          const std::string             &file,
+                                          ISOLang                        lang,
+                                          OcrProfile                     profile,
+                                          std::size_t                    image_size) -> ImagePtr {
+            if (!fuzzhash) {
+                return nullptr;
+            }
+
+            auto match_key = near_index->findNearest(*fuzzhash, nearDuplicateTag(lang, profile));
+            if (!match_key) {
+                return nullptr;
+            }
+
+            std::string text;
+            if (auto source = getFromCacheIfExists(*match_key)) {
+                text = source->text();
+            } else if (auto record = store ? store->lookup(*match_key) : std::nullopt) {
+                text = std::move(record->text);
+            } else {
+                return nullptr;
+            }
+
+            Image image(img_sha, file, text, image_size, lang, profile);
+            image.content_fuzzhash = fuzzhash->toString();
+
+            auto cachedImage = cacheImage(std::move(image));
+
+            persistImage(*cachedImage);
+            shareImage(*cachedImage);
+
+            return cachedImage;
+        }
+
+        /// @brief Consult the Cache shared with sibling Processes on the Host - a Hit is promoted
+        /// into the in-memory Cache
+        /// @param img_sha
+        /// @param file
+        /// @param lang
+        /// @param profile
+        /// @param image_size
+        /// @return ImagePtr - nullptr if the Shared Cache is disabled or does not hold the Key
+        auto getFromSharedCacheIfExists(const Sha256Digest &img_sha,
+                                        const std::string  &file,
+                                        ISOLang             lang,
+                                        OcrProfile          profile,
+                                        std::size_t         image_size) -> ImagePtr {
+            if (!shared_cache) {
+                return nullptr;
+            }
+
+            auto text = shared_cache->lookup(cacheKey(img_sha, lang, profile));
+            if (!text) {
+                return nullptr;
+            }
+
+            return cacheImage(Image(img_sha, file, *text, image_size, lang, profile));
+        }
+
+        void shareImage(const Image &image) {
+            auto key = cacheKey(image.image_sha256, image.lang, image.profile);
+
+            if (shared_cache && !shared_cache->insert(key, image.text())) {
+                logger->log() << fmtstr(
+                    "{0}Shared Cache {1} is full{2}\n", WARNING, shared_cache->path(), END);
+            }
+        }
+
+        void persistImage(const Image &image) {
+            auto key = cacheKey(image.image_sha256, image.lang, image.profile);
+
+            if (!store || store->contains(key)) {
+                return;
+            }
+
+            HandleError<StdErr>(store->append(
+                {key, image.path, image.text(), image.content_fuzzhash, image.image_size}));
         }
 
         std::vector<std::string> processCurrentFiles() {
@@ -225,7 +940,7 @@ namespace imgstr {
             for (const auto &file: files) {
                 auto image = processImageFile(file);
                 if (image) {
-                    processedText.emplace_back(image.value().get().text_content);
+                    processedText.emplace_back(image->text());
                 }
             }
 
@@ -279,6 +994,37 @@ namespace imgstr {
                 "\n{0}{1}  Cache Hit : {2}{3}\n", SUCCESS_TICK, GREEN, END, file);
         }
 
+        void printNearDuplicateHit(const std::string &file) {
+            logger->log() << fmtstr(
+                "\n{0}{1}  Near Duplicate Hit : {2}{3}\n", SUCCESS_TICK, GREEN, END, file);
+        }
+
+        void printInFlightHit(const std::string &file) {
+            logger->log() << fmtstr("\n{0}{1}  Duplicate In Flight - reused OCR : {2}{3}\n",
+                                    SUCCESS_TICK,
+                                    GREEN,
+                                    END,
+                                    file);
+        }
+
+        void printSharedCacheHit(const std::string &file) {
+            logger->log() << fmtstr(
+                "\n{0}{1}  Shared Cache Hit : {2}{3}\n", SUCCESS_TICK, GREEN, END, file);
+        }
+
+        void printStoreHit(const std::string &file) {
+            logger->log() << fmtstr(
+                "\n{0}{1}  Persistent Cache Hit : {2}{3}\n", SUCCESS_TICK, GREEN, END, file);
+        }
+
+        void printOcrTimeout(const std::string &file, OcrLane lane) {
+            logger->log() << fmtstr("{0}OCR Deadline exceeded{1} ({2} lane) : {3}\n",
+                                    WARNING,
+                                    END,
+                                    lane == OcrLane::slow ? "slow" : "normal",
+                                    file);
+        }
+
         void printFileProcessingFailure(const std::string &file, const std::string &err_msg) {
             logger->log() << fmtstr(
                 "Failed to Extract Text from Image file: {0}. Error: {1}\n", file, err_msg);
@@ -354,9 +1100,7 @@ namespace imgstr {
                                 END,
                                 DELIMITER_STAR);
 
-            for (const auto &img_sha: cache) {
-                const Image &img = img_sha.second;
-
+            cache.forEach([&logstream](const Sha256Digest &, const Image &img) {
                 logstream << fmtstr("{0}SHA256:          {1}{2}\n"
                                     "{3}Path:            {1}{4}\n"
                                     "{3}Image Size:      {1}{5:N} bytes\n"
@@ -368,7 +1112,7 @@ namespace imgstr {
                                     "{11}\n",
                                     Ansi::GREEN_BOLD,
                                     Ansi::END,
-                                    img.image_sha256,
+                                    img.image_sha256.toHex(),
                                     Ansi::BLUE,
                                     img.path,
                                     img.image_size,
@@ -378,7 +1122,7 @@ namespace imgstr {
                                     (img.write_info.output_written ? "Yes" : "No"),
                                     img.write_info.write_timestamp,
                                     Ansi::DELIMITER_ITEM);
-            }
+            });
 
             logstream.flush();
         }
@@ -389,7 +1133,7 @@ namespace imgstr {
                                     "Processed :: {6} {7}\n",
                                     LIGHT_GREY,
                                     BRIGHT_WHITE,
-                                    TesseractThreadCount.load(std::memory_order_relaxed),
+                                    engines.size(),
                                     END,
                                     BOLD_WHITE,
                                     getAverageProcessingTime(),
@@ -401,8 +1145,13 @@ namespace imgstr {
         }
 
       public:
+        /// @param capacity
+        /// @param cores
+        /// @param prewarm - initialize one Engine per Core up front, see setPrewarm()
         template <typename T>
-        ImgProcessor(size_t capacity = 1000, T cores = 1): ImgProcessor(capacity) {
+        ImgProcessor(size_t capacity = 1000, T cores = 1, bool prewarm = false)
+            : ImgProcessor(capacity) {
+            prewarm_engines = prewarm;
             setCores(cores);
         }
 
@@ -410,10 +1159,21 @@ namespace imgstr {
 
             : num_cores(CORES::single),
               logger(std::make_unique<AsyncLogger>()),
-              cache(folly::AtomicUnorderedInsertMap<std::string, Image>(capacity)),
+              cache(capacity, DEFAULT_CACHE_BYTES),
               img_mode(ImgMode::document) {
             initLog();
 
+            // the Path Index resolves to the Content Digest - evicting one Language or Profile of
+            // an Image only costs its other cached Variants the stat() Shortcut
+            cache.onEvict([this](const Sha256Digest &key, const Image &image) {
+                if (near_index) {
+                    near_index->erase(key);
+                }
+                if (path_index) {
+                    path_index->erase(image.image_sha256);
+                }
+            });
+
             setCores(num_cores);
         }
 
@@ -423,8 +1183,13 @@ namespace imgstr {
         auto operator=(ImgProcessor &&) -> ImgProcessor      & = delete;
 
         ~ImgProcessor() {
+            if (!snapshot_path.empty()) {
+                HandleError<StdErr>(exportCacheSnapshot(snapshot_path));
+            }
             destructionLog();
             completeAllThreads();
+            // Pool Engines die with the Pool, the free getTextOCR() Helpers still keep one per
+            // OpenMP Thread
             cleanupOpenMPTesserat();
         }
 
@@ -436,28 +1201,47 @@ namespace imgstr {
         /// @brief Get Text from a Single Image File - part of the processing pipeline
         /// @param file_path
         /// @param lang = "en"
+        /// @param profile - overrides the Processor's Profile for this Call
         /// @return std::optional<std::string>
-        auto getImageText(const std::string &file_path,
-                          ISOLang            lang = ISOLang::en) -> std::optional<std::string> {
-            auto image = processImageFile(file_path);
+        auto getImageText(const std::string        &file_path,
+                          ISOLang                   lang    = ISOLang::en,
+                          std::optional<OcrProfile> profile = std::nullopt)
+            -> std::optional<std::string> {
+            auto image = processImageFile(file_path, lang, profile);
 
             if (image) {
-                return image.value().get().text_content;
+                return image->text();
             }
 
             return std::nullopt;
         }
 
-        /// @brief Get Text from a Single Image File - for individual Static Calls
+        /// @brief Get Text from a Single Image File - for individual Static Calls. Every Page of a
+        /// multi-page File is read, Pages separated by Form Feeds.
         /// @param file_path
         /// @param lang = "en"
+        /// @param profile - overrides the Processor's Profile for this Call
         /// @return std::optional<std::string>
-        auto getTextFromImage(const std::string &imagePath,
-                              ISOLang            lang = ISOLang::en) -> std::string {
-            auto file_content = readBytesFromFile(imagePath);
-            auto img_text     = getTextOCRNoClear(file_content);
+        auto getTextFromImage(const std::string        &imagePath,
+                              ISOLang                   lang    = ISOLang::en,
+                              std::optional<OcrProfile> profile = std::nullopt) -> std::string {
+            return recognizeFile(imagePath, lang, profile.value_or(ocr_profile));
+        }
 
-            return img_text;
+        /// @brief Text of every Page of an Image File, bypassing the File Cache for single
+        /// Images. Multi-page Files go through recognizeDocument() - Pages separated by Form Feeds.
+        auto recognizeFile(const std::string &imagePath, ISOLang lang, OcrProfile profile)
+            -> std::string {
+            auto                data  = readBytesFromFile(imagePath);
+            std::vector<PixPtr> pages = decodePages(data);
+
+            if (pages.size() > 1) {
+                auto document = recognizeDocument(computeSHA256(data), imagePath, lang, profile,
+                                                  data.size(), pages, std::nullopt, false);
+                return document->text();
+            }
+
+            return recognizePix(pages.front().get(), lang, profile);
         }
 
         /// @brief Convert a Single Image File and Write to an Output File
@@ -509,7 +1293,10 @@ namespace imgstr {
         /// as an Isolated Job
         /// @param directory
         /// @param output_path
-        void simpleProcessDir(const std::string &directory, const std::string &output_path = "") {
+        /// @param lang
+        void simpleProcessDir(const std::string &directory,
+                              const std::string &output_path = "",
+                              ISOLang            lang        = ISOLang::en) {
             std::vector<std::string> imageFiles;
 
             llvm::outs() << "Processing Images Dir" << '\n';
@@ -545,9 +1332,8 @@ namespace imgstr {
 
             for (const auto &imagePath: imageFiles) {
                 START_TIMING();
-                auto file_content = readBytesFromFile(imagePath);
-                auto img_text     = getTextOCRNoClear(file_content);
-                auto out_path     = createQualifiedFilePath(imagePath, output_path, ".txt");
+                auto img_text = recognizeFile(imagePath, lang, ocr_profile);
+                auto out_path = createQualifiedFilePath(imagePath, output_path, ".txt");
 
                 HandleError<StdErr>(writeStringToFile(out_path.get(), img_text));
 
@@ -562,48 +1348,147 @@ namespace imgstr {
         ///   @param input_file The input image file.
         ///   @param output_dir The output directory (optional).
         ///   @param lang The language of the text (optional, default: en).
+        ///   @param format hOCR, TSV or ALTO instead of plain Text (optional).
+        ///   @param lane The OCR Budget if enableOcrDeadline() is set (optional).
         ///   @return void
         ///   @usage convertImageToTextFile("image.jpg", "output_dir", ISOLang::en);
         ///
         void convertImageToTextFile(const std::string &input_file,
                                     const std::string &output_path = "",
                                     bool               create_dir  = true,
-                                    ISOLang            lang        = ISOLang::en) {
+                                    ISOLang            lang        = ISOLang::en,
+                                    OutputFormat       format      = OutputFormat::text,
+                                    OcrLane            lane        = OcrLane::normal) {
             if (create_dir && !output_path.empty()) {
                 Unwrap<StdErr>(createDirectories(output_path));
             }
 
-            auto output_file = createQualifiedFilePath(input_file, output_path, ".txt");
+            auto output_file =
+                createQualifiedFilePath(input_file, output_path, formatExtension(format));
 
             if (!output_file) {
                 serrfmt("Failed to Create Qualified Path:{0}\n", input_file);
                 return;
             }
 
-            auto imageOpt = getImageOrProcess(input_file, lang);
+            bool structured = format != OutputFormat::text;
 
-            if (!imageOpt) {
-                serrfmt("Failed to Retrieve or Process Image : {0}\n", input_file);
+            // Words are kept per Page only - reject before any Page is recognized
+            if (structured && countPages(input_file) > 1) {
+                printFileProcessingFailure(input_file,
+                                           "hOCR, TSV and ALTO output is single-page only");
                 return;
             }
 
-            const Image &image = imageOpt.value().get();
+            auto imagePtr = getImageOrProcess(input_file, lang, std::nullopt, lane, structured);
+
+            if (!imagePtr) {
+                // Timeouts are reported when cancelled and retried by processSlowLane()
+                if (!isTimedOut(input_file)) {
+                    serrfmt("Failed to Retrieve or Process Image : {0}\n", input_file);
+                }
+                return;
+            }
+
+            const Image &image = *imagePtr;
+
+            if (structured) {
+                writeStructuredOutput(image, input_file, output_file.get(), format, lang, lane);
+                return;
+            }
 
             if (image.write_info.output_written) {
                 printOutputAlreadyWritten(image);
                 return;
             }
 
-            if (HandleError<StdErr>(writeStringToFile(output_file.get(), image.text_content))) {
+            if (HandleError<StdErr>(writeStringToFile(output_file.get(), image.text()))) {
                 image.updateWriteInfo(output_file.get(), getCurrentTimestamp(), true);
             }
         }
 
+        /// @brief Stream the Words of an Image to output_file as hOCR, TSV or ALTO. Words come from
+        /// the Recognition that produced the Text; Images cached without them - before Word
+        /// Results were kept, or served from the Persistent Store - are read once more under the
+        /// Budget of the Lane and the Words kept on the cached Entry, so the next structured
+        /// Output is not read again. A Re-read that times out is left to processSlowLane().
+        void writeStructuredOutput(const Image       &image,
+                                   const std::string &input_file,
+                                   const std::string &output_file,
+                                   OutputFormat       format,
+                                   ISOLang            lang,
+                                   OcrLane            lane) {
+            const Image *source = &image;
+            ImagePtr     updated;
+
+            try {
+                if (image.words.empty() && !image.skipped && image.text_size > 0) {
+                    auto pages = decodePages(readBytesFromFile(input_file));
+                    if (pages.size() > 1) {
+                        printFileProcessingFailure(
+                            input_file, "hOCR, TSV and ALTO output is single-page only");
+                        return;
+                    }
+
+                    std::optional<OcrDeadline> deadline;
+                    if (auto budget = laneBudget(lane)) {
+                        deadline = std::chrono::steady_clock::now() + *budget;
+                    }
+
+                    OcrWords reread;
+                    recognizePix(pages.front().get(), lang, image.profile, deadline, &reread);
+
+                    updated = cacheWords(image, std::move(reread));
+                    source  = updated.get();
+                }
+            } catch (const OcrTimeoutError &e) {
+                bump(counters.timeouts);
+                markTimedOut(input_file);
+                printOcrTimeout(input_file, lane);
+                return;
+            } catch (const std::exception &e) {
+                printFileProcessingFailure(input_file, e.what());
+                return;
+            }
+
+            if (HandleError<StdErr>(
+                    writeOcrFile(output_file, format, source->words, source->getName()))) {
+                source->updateWriteInfo(output_file, getCurrentTimestamp(), true);
+            }
+        }
+
+        /// @brief Replace the cached Entry of an Image with a Copy holding its re-read Words
+        /// @param image - the cached Entry, left untouched for Readers that still hold it
+        /// @param words
+        /// @return ImagePtr - the Copy, cached under the same Key
+        auto cacheWords(const Image &image, OcrWords &&words) -> ImagePtr {
+            Image copy(image.image_sha256, image.path, image.text(), image.image_size, image.lang,
+                       image.profile);
+            copy.time_processed   = image.time_processed;
+            copy.content_fuzzhash = image.content_fuzzhash;
+            copy.write_info       = image.readWriteInfoSafe();
+            copy.words            = std::move(words);
+
+            if (compress_text) {
+                copy.compressTextContent();
+            }
+
+            auto bytes = copy.footprint();
+            auto key   = cacheKey(copy.image_sha256, copy.lang, copy.profile);
+            return cache.replace(key, std::move(copy), bytes);
+        }
+
         /// @brief Process Files with Available Cores Defined during Class Instantiation
         /// @param output_dir
         /// @param lang
+        /// @param format - Output of the whole Batch; hOCR, TSV and ALTO are streamed from the
+        /// Words of the same Recognition as the Text
+        /// @code{.cpp}
+        ///     processor.convertImagesToTextFilesParallel("out", ISOLang::en, OutputFormat::hocr);
+        /// @endcode
         void convertImagesToTextFilesParallel(const std::string &output_dir = "",
-                                              ISOLang            lang       = ISOLang::en) {
+                                              ISOLang            lang       = ISOLang::en,
+                                              OutputFormat       format     = OutputFormat::text) {
             if (!output_dir.empty() && !file_exists(output_dir) && !createDirectories(output_dir)) {
                 return;
             }
@@ -616,10 +1501,45 @@ namespace imgstr {
 #pragma omp parallel for
             for (const auto &file: queued) {
                 START_TIMING();
-                convertImageToTextFile(file, output_dir, false, lang);
+                convertImageToTextFile(file, output_dir, false, lang, format);
                 END_TIMING("parallel() - file processed ");
             }
             queued.clear();
+
+            if (deadlines && deadlines->slow_lane) {
+                processSlowLane(output_dir, lang, format);
+            }
+        }
+
+        /// @brief Retry the Images cancelled at the normal Deadline under the slow Budget, after
+        /// the fast Images of the Batch have been written. Images that time out again stay in
+        /// getTimedOutFiles().
+        /// @param output_dir
+        /// @param lang
+        /// @param format
+        void processSlowLane(const std::string &output_dir = "",
+                             ISOLang            lang       = ISOLang::en,
+                             OutputFormat       format     = OutputFormat::text) {
+            std::vector<std::string> retry;
+            {
+                std::lock_guard<std::mutex> lock(timed_out_mutex);
+                retry.assign(timed_out.begin(), timed_out.end());
+                timed_out.clear();
+            }
+
+            if (retry.empty()) {
+                return;
+            }
+
+            logger->log() << fmtstr("{0}Slow lane{1} : retrying {2} timed out Images\n",
+                                    WARNING,
+                                    END,
+                                    retry.size());
+
+#pragma omp parallel for
+            for (const auto &file: retry) {
+                convertImageToTextFile(file, output_dir, false, lang, format, OcrLane::slow);
+            }
         }
 
         void convertImagesToTextFiles(const std::string &output_dir = "",
@@ -654,6 +1574,83 @@ namespace imgstr {
 
         void setImageMode(ImgMode img_mode) { this->img_mode = img_mode; }
 
+        /// @brief Speed / Accuracy Profile of the Engines used when a Call does not pick one.
+        /// Each Profile has its own Engine Pools and Cache Keys, so Text recognized with the
+        /// fast Profile is never served to a Call asking for accurate.
+        /// @param profile
+        /// @code{.cpp}
+        ///     processor.setProfile(OcrProfile::fast); // bulk Job
+        ///     auto text = processor.getImageText(path, ISOLang::en, OcrProfile::accurate);
+        /// @endcode
+        void setProfile(OcrProfile profile) { ocr_profile = profile; }
+
+        auto getProfile() const -> OcrProfile { return ocr_profile; }
+
+        /// @brief Read every Image with the cheap options.first_pass Profile first and re-read
+        /// only low Confidence Images - or only their low Confidence Blocks - with the requested
+        /// Profile. Results are cached under the requested Profile; Pass Counts are reported in
+        /// CacheStats. Calls already asking for options.first_pass run a single Pass.
+        /// @param options
+        /// @code{.cpp}
+        ///     processor.setProfile(OcrProfile::accurate);
+        ///     processor.enableAdaptiveOCR({.min_mean_conf = 85});
+        /// @endcode
+        void enableAdaptiveOCR(const AdaptiveOptions &options = {}) { adaptive = options; }
+
+        void disableAdaptiveOCR() { adaptive.reset(); }
+
+        /// @brief Cancel Recognition of an Image once it has run for options.budget. Cancelled
+        /// Images are not cached, are counted as CacheStats::timeouts and, with
+        /// options.slow_lane, retried by convertImagesToTextFilesParallel() after the Batch.
+        /// @param options
+        /// @code{.cpp}
+        ///     using namespace std::chrono_literals;
+        ///     processor.enableOcrDeadline({.budget = 5s, .slow_budget = 60s});
+        /// @endcode
+        void enableOcrDeadline(const DeadlineOptions &options = {}) { deadlines = options; }
+
+        void disableOcrDeadline() { deadlines.reset(); }
+
+        /// @brief Keep the Words of every Image recognized from now on - Text, Boxes,
+        /// Confidences and Line / Block Ids from the same OCR Pass as the Text, cached with it.
+        /// Images are then read in one full Pass, bypassing Strip, Layout and adaptive OCR.
+        /// Words are held in memory only; Images served from the Persistent Store, Shared Cache
+        /// or a Snapshot carry none.
+        /// @code{.cpp}
+        ///     processor.enableWordResults();
+        ///     auto words = processor.getImageWords("scan.png");
+        ///     for (std::size_t i = 0; words && i < words->size(); ++i) {
+        ///         if (words->word(i) == "invoice") { highlight(words->boxes[i]); }
+        ///     }
+        /// @endcode
+        void enableWordResults() { word_results = true; }
+
+        void disableWordResults() { word_results = false; }
+
+        /// @brief Words of an Image, recognizing it if it is not cached yet
+        /// @param file_path
+        /// @param lang
+        /// @param profile - overrides the Processor's Profile for this Call
+        /// @return std::shared_ptr<const OcrWords> - shares Ownership with the cached Image,
+        /// nullptr if the Image could not be processed
+        auto getImageWords(const std::string        &file_path,
+                           ISOLang                   lang    = ISOLang::en,
+                           std::optional<OcrProfile> profile = std::nullopt)
+            -> std::shared_ptr<const OcrWords> {
+            auto image = processImageFile(file_path, lang, profile);
+
+            if (!image) {
+                return nullptr;
+            }
+            return {image, &image->words};
+        }
+
+        /// @brief Files whose last Recognition was cancelled at its Deadline
+        auto getTimedOutFiles() -> std::vector<std::string> {
+            std::lock_guard<std::mutex> lock(timed_out_mutex);
+            return {timed_out.begin(), timed_out.end()};
+        }
+
         template <typename T>
         void setCores(T cores) {
             if constexpr (std::is_same_v<T, CORES>) {
@@ -683,15 +1680,336 @@ namespace imgstr {
             } else {
                 static_assert(always_false<T>, "Unsupported type for setCores");
             }
+
+            engines.resize(omp_get_max_threads());
+
+            if (prewarm_engines) {
+                warmEngines();
+            }
         }
 
+        /// @brief Split tall Pages into horizontal Strips at whitespace Gaps and OCR the Strips in
+        /// parallel on pooled Engines - cuts single Document Latency when Cores would otherwise
+        /// sit idle (processSingleImage(), the CLI). Size the Pool with setCores() first. Images
+        /// recognized by a Batch (OpenMP parallel Region) are read whole.
+        /// @param options
+        /// @code{.cpp}
+        ///     processor.setCores(CORES::max);
+        ///     processor.enableStripOCR({.min_height = 3000});
+        /// @endcode
+        void enableStripOCR(const StripOptions &options = {}) { strip_ocr = options; }
+
+        void disableStripOCR() { strip_ocr.reset(); }
+
+        /// @brief Downscale Images whose Text is larger than Tesseract needs before OCR - Phone
+        /// Photos and HiDPI Screenshots often arrive at 3-4x the useful Resolution. The x-height
+        /// is estimated per Image, see benchmarks/resolution_benchmark.cc for the Trade-off.
+        /// @param options
+        /// @code{.cpp}
+        ///     processor.enableResolutionNormalization({.target_x_height = 20});
+        /// @endcode
+        void enableResolutionNormalization(const ResolutionOptions &options = {}) {
+            resolution = options;
+        }
+
+        void disableResolutionNormalization() { resolution.reset(); }
+
+        /// @brief Classify Images before OCR and skip blank Separator Pages - Pages with any Ink,
+        /// even a lone Page Number, are still read. Skipped Images are cached with empty Text and
+        /// Image::skipped set, and counted in CacheStats::skipped.
+        /// @param options
+        /// @code{.cpp}
+        ///     processor.enableBlankDetection({.min_ink_fraction = 0.0001F});
+        /// @endcode
+        void enableBlankDetection(const BlankOptions &options = {}) { blank_detection = options; }
+
+        void disableBlankDetection() { blank_detection.reset(); }
+
+        /// @brief In ImgMode::image, run Layout Analysis first and recognize only the Text
+        /// Blocks it finds - Photos and Diagrams no longer pay for Recognition of Graphics.
+        /// Takes precedence over enableStripOCR() for those Images, ImgMode::document is
+        /// unaffected.
+        /// @param options
+        /// @code{.cpp}
+        ///     processor.setImageMode(ImgMode::image);
+        ///     processor.enableLayoutFilter({.min_area = 0.001F});
+        /// @endcode
+        void enableLayoutFilter(const LayoutOptions &options = {}) { layout_filter = options; }
+
+        void disableLayoutFilter() { layout_filter.reset(); }
+
+        /// @brief Replace the Preprocessing applied to every Image before OCR. Runs after
+        /// Resolution Normalization, so Steps work on the smaller Image. Set it before
+        /// processing starts - the Pipeline is not guarded against concurrent Replacement.
+        /// @param pipeline
+        /// @code{.cpp}
+        ///     PreprocessPipeline pipeline;
+        ///     pipeline.grayscale().binarize().deskew();
+        ///     processor.setPreprocessing(std::move(pipeline));
+        /// @endcode
+        void setPreprocessing(PreprocessPipeline pipeline) { preprocessing = std::move(pipeline); }
+
+        /// @brief Time spent in each Preprocessing Step so far
+        /// @return std::vector<StepTiming>
+        auto getPreprocessTimings() const -> std::vector<StepTiming> {
+            return preprocessing.timings();
+        }
+
+        void printPreprocessTimings() const {
+            for (const auto &step: preprocessing.timings()) {
+                llvm::outs() << fmtstr("{0,-12} : {1} runs ({2} unchanged), {3:f2} ms total, "
+                                       "{4:f3} ms avg\n",
+                                       step.name, step.runs, step.skipped, step.total_ms,
+                                       step.meanMs());
+            }
+        }
+
+        /// @brief Initialize Engines for every Core whenever setCores() runs, so steady state
+        /// Latency starts at the first Request instead of after each Worker's first Image
+        /// @param prewarm
+        void setPrewarm(bool prewarm) { prewarm_engines = prewarm; }
+
+        /// @brief Initialize one Engine per OpenMP Thread for the Language in parallel and log
+        /// the Init Time of each
+        /// @param lang
+        /// @return std::vector<double> - Init Time in ms of each newly created Engine
+        auto warmEngines(ISOLang lang = ISOLang::en) -> std::vector<double> {
+            const char *lang_code = isoToTesseractLang(lang);
+            auto        start     = getStartTime();
+
+            std::vector<double> init_ms;
+            try {
+                init_ms = engines.get(lang_code, ocr_profile).warm(omp_get_max_threads());
+            } catch (const std::exception &e) {
+                logger->log() << fmtstr(
+                    "{0}Engine warm-up failed : {1}{2}\n", ERROR, e.what(), END);
+                return init_ms;
+            }
+
+            for (std::size_t i = 0; i < init_ms.size(); ++i) {
+                logger->log() << fmtstr("{0}Engine {1} ({2}){3} initialized in {4:f2} ms\n",
+                                        BOLD_WHITE,
+                                        i,
+                                        lang_code,
+                                        END,
+                                        init_ms[i]);
+            }
+
+            logger->log() << fmtstr("{0}{1} Engines warmed in {2:f2} ms{3}\n",
+                                    BOLD_WHITE,
+                                    init_ms.size(),
+                                    getDuration(start),
+                                    END);
+
+            return init_ms;
+        }
+
+        /// @brief Bound the number of Tesseract Engines independently of the OpenMP Thread Count.
+        /// setCores() sizes the Pool to the Thread Count, callers driving the Processor from
+        /// their own Threads can raise or lower it here. The Bound applies to each (Language,
+        /// Profile) Pool separately - mixing Languages or Profiles multiplies the Engines held.
+        /// @param max_engines - per Language and Profile
+        void setEnginePoolSize(std::size_t max_engines) { engines.resize(max_engines); }
+
         template <typename T>
         inline static constexpr bool always_false = false;
 
+        /// @brief Attach a Persistent On-Disk Cache Tier. Images already present in the Store are
+        /// served without OCR and every newly processed Image is appended to it.
+        /// @param store_path
+        /// @return llvm::Error
+        /// @code{.cpp}
+        ///     HandleError<StdErr>(processor.enablePersistentCache("textract.kimg"));
+        /// @endcode
+        auto enablePersistentCache(const std::string &store_path) -> llvm::Error {
+            auto storeOrErr = ImageStore::open(store_path);
+            if (!storeOrErr) {
+                return storeOrErr.takeError();
+            }
+
+            store = std::move(storeOrErr.get());
+
+            logger->log() << fmtstr("{0}Persistent Cache{1} {2} : {3} images\n",
+                                    BOLD_WHITE,
+                                    END,
+                                    store_path,
+                                    store->size());
+
+            return llvm::Error::success();
+        }
+
+        /// @brief Share OCR Results with every Process on the Host that enables the same File.
+        /// Images recognized by any of them are served from the shared Mapping instead of being
+        /// re-OCR'd. The Geometry only applies when the File is created.
+        /// @param shm_path - e.g. a File under /dev/shm
+        /// @param slot_count - maximum number of Images
+        /// @param arena_bytes - Bytes available for Text
+        /// @return llvm::Error
+        /// @code{.cpp}
+        ///     HandleError<StdErr>(processor.enableSharedCache("/dev/shm/textract.shm"));
+        /// @endcode
+        auto enableSharedCache(const std::string &shm_path,
+                               uint64_t           slot_count  = 1 << 16,
+                               uint64_t           arena_bytes = DEFAULT_CACHE_BYTES)
+            -> llvm::Error {
+            auto shmOrErr = SharedMemoryCache::open(shm_path, slot_count, arena_bytes);
+            if (!shmOrErr) {
+                return shmOrErr.takeError();
+            }
+
+            shared_cache = std::move(shmOrErr.get());
+
+            logger->log() << fmtstr("{0}Shared Cache{1} {2} : {3} / {4} images\n",
+                                    BOLD_WHITE,
+                                    END,
+                                    shm_path,
+                                    shared_cache->size(),
+                                    shared_cache->capacity());
+
+            return llvm::Error::success();
+        }
+
+        /// @brief Write every cached Image - Text, Hashes and Write Metadata - to a single
+        /// Snapshot File that importCacheSnapshot() can load on the next start
+        /// @param snapshot_file
+        /// @return llvm::Error
+        auto exportCacheSnapshot(const std::string &snapshot_file) -> llvm::Error {
+            std::vector<SnapshotEntry> entries;
+            entries.reserve(cache.size());
+
+            cache.forEach([&entries](const Sha256Digest &, const Image &img) {
+                auto info = img.readWriteInfoSafe();
+                entries.push_back({img.image_sha256,
+                                   img.path,
+                                   img.text_content,
+                                   img.time_processed,
+                                   img.content_fuzzhash,
+                                   std::move(info.output_path),
+                                   std::move(info.write_timestamp),
+                                   img.text_size,
+                                   img.image_size,
+                                   img.text_compressed,
+                                   info.output_written,
+                                   img.skipped,
+                                   img.lang,
+                                   img.profile});
+            });
+
+            if (auto err = writeSnapshot(snapshot_file, entries)) {
+                return err;
+            }
+
+            logger->log() << fmtstr("{0}Cache Snapshot{1} {2} : {3} images\n",
+                                    BOLD_WHITE,
+                                    END,
+                                    snapshot_file,
+                                    entries.size());
+
+            return llvm::Error::success();
+        }
+
+        /// @brief Warm the Cache from a Snapshot written by exportCacheSnapshot(). Only Text,
+        /// Hashes and Stats are restored - Images are not marked as written, so the Output Files
+        /// of this Run are still produced even if a previous Run wrote them.
+        /// @param snapshot_file
+        /// @return llvm::Expected<size_t> - number of Images loaded
+        auto importCacheSnapshot(const std::string &snapshot_file) -> llvm::Expected<size_t> {
+            auto entriesOrErr = readSnapshot(snapshot_file);
+            if (!entriesOrErr) {
+                return entriesOrErr.takeError();
+            }
+
+            for (auto &entry: *entriesOrErr) {
+                Image image(entry.hash,
+                            std::move(entry.uri),
+                            "",
+                            entry.image_size,
+                            entry.lang,
+                            entry.profile);
+                image.text_content     = std::move(entry.text);
+                image.text_size        = entry.text_size;
+                image.text_compressed  = entry.text_compressed;
+                image.skipped          = entry.skipped;
+                image.time_processed   = std::move(entry.time_processed);
+                image.content_fuzzhash = std::move(entry.fuzzhash);
+
+                if (near_index) {
+                    if (auto fuzzhash = FuzzHash::fromString(image.content_fuzzhash)) {
+                        near_index->insert(*fuzzhash,
+                                           cacheKey(entry.hash, entry.lang, entry.profile),
+                                           nearDuplicateTag(entry.lang, entry.profile));
+                    }
+                }
+
+                cacheImage(std::move(image));
+            }
+
+            return entriesOrErr->size();
+        }
+
+        /// @brief Load the Snapshot at the Path if present and export the Cache back to it when
+        /// the Processor is destroyed - restarted Workers start warm instead of re-running OCR
+        /// @param snapshot_file
+        /// @return llvm::Error
+        /// @code{.cpp}
+        ///     HandleError<StdErr>(processor.enableCacheSnapshot("textract.snap"));
+        /// @endcode
+        auto enableCacheSnapshot(const std::string &snapshot_file) -> llvm::Error {
+            if (llvm::sys::fs::exists(snapshot_file)) {
+                auto loadedOrErr = importCacheSnapshot(snapshot_file);
+                if (!loadedOrErr) {
+                    return loadedOrErr.takeError();
+                }
+
+                logger->log() << fmtstr("{0}Cache Snapshot{1} warm start : {2} images\n",
+                                        BOLD_WHITE,
+                                        END,
+                                        *loadedOrErr);
+            }
+
+            snapshot_path = snapshot_file;
+
+            return llvm::Error::success();
+        }
+
+        /// @brief Drop all cached Images and apply a new Entry Capacity
+        /// @param new_capacity
         void resetCache(size_t new_capacity) {
-            cache = folly::AtomicUnorderedInsertMap<std::string, Image>(new_capacity);
+            cache.reset(new_capacity, cache.maxBytes());
+            if (path_index) {
+                path_index->clear();
+            }
+            if (near_index) {
+                near_index->clear();
+            }
+        }
+
+        /// @brief Skip OCR for Images that are perceptual Duplicates of an already processed Image.
+        /// A 256 bit dHash is stored in Image::content_fuzzhash and Images within `radius`
+        /// differing bits (and the same aspect ratio) reuse the cached Text.
+        /// @param radius - Hamming Distance out of 256 bits, 0 disables near matching
+        void enableNearDuplicates(unsigned radius = 8) {
+            near_index = radius > 0 ? std::make_unique<NearDuplicateIndex>(radius) : nullptr;
+        }
+
+        /// @brief Store cached Text zlib compressed - decompressed lazily when the Text is read or
+        /// written out. Lets the same Byte Budget hold several times more Images.
+        /// @param enable
+        void setCompressText(bool enable = true) { compress_text = enable; }
+
+        /// @brief Resolve Files by (device, inode, size, mtime) before reading them. A re-scan of
+        /// unchanged Files then costs one stat() per File - the Bytes are only read and hashed
+        /// again once the File's metadata changes.
+        /// @param enable
+        void enableStatIndex(bool enable = true) {
+            path_index = enable ? std::make_unique<PathIndex>() : nullptr;
         }
 
+        /// @brief Bound the in-memory Cache by the Bytes held in cached Images (text and metadata).
+        /// Least recently used Images are evicted (CLOCK) once the Budget is exceeded.
+        /// @param max_bytes
+        void setCacheBudget(size_t max_bytes) { cache.setByteBudget(max_bytes); }
+
         /// @brief Add Files to the Queue for Processing. Methods such as
         /// convertImagesToTextFiles(outputDir) will then begin processing all Files from the Queue
         ///
@@ -723,6 +2041,69 @@ namespace imgstr {
         }
 
         void getResults() { printImagesInfo(); }
+
+        /// @brief Snapshot of Cache Hits, Misses and Occupancy since the Processor was created.
+        /// Time saved is estimated as every Hit costing the average measured OCR Latency.
+        /// @code{.cpp}
+        ///     auto stats = imageTranslator.getCacheStats();
+        ///     sout << stats.hitRatio() << " " << stats.time_saved_ms << "ms\n";
+        /// @endcode
+        auto getCacheStats() const -> CacheStats {
+            CacheStats stats;
+            stats.hits           = counters.hits.load(std::memory_order_relaxed);
+            stats.stat_hits      = counters.stat_hits.load(std::memory_order_relaxed);
+            stats.store_hits     = counters.store_hits.load(std::memory_order_relaxed);
+            stats.shared_hits    = counters.shared_hits.load(std::memory_order_relaxed);
+            stats.near_hits      = counters.near_hits.load(std::memory_order_relaxed);
+            stats.in_flight_hits = counters.in_flight_hits.load(std::memory_order_relaxed);
+            stats.misses         = counters.misses.load(std::memory_order_relaxed);
+            stats.skipped        = counters.skipped.load(std::memory_order_relaxed);
+            stats.first_pass     = counters.first_pass.load(std::memory_order_relaxed);
+            stats.second_pass    = counters.second_pass.load(std::memory_order_relaxed);
+            stats.regions_rerun  = counters.regions_rerun.load(std::memory_order_relaxed);
+            stats.timeouts       = counters.timeouts.load(std::memory_order_relaxed);
+            stats.pages          = counters.pages.load(std::memory_order_relaxed);
+            stats.inserts        = cache.insertCount();
+            stats.evictions      = cache.evictionCount();
+            stats.duplicates     = stats.hits + stats.stat_hits + stats.in_flight_hits;
+            stats.entries        = cache.size();
+            stats.capacity       = cache.maxEntries();
+            stats.bytes_stored   = cache.bytes();
+            stats.byte_budget    = cache.maxBytes();
+            stats.ocr_ms         = counters.ocr_us.load(std::memory_order_relaxed) / 1000.0;
+
+            if (stats.misses > 0) {
+                stats.time_saved_ms = stats.ocr_ms / stats.misses * stats.totalHits();
+            }
+
+            return stats;
+        }
+
+        void printCacheStats() const {
+            auto stats = getCacheStats();
+
+            printKeyValuePairsList(
+                {{"Cache Hits", std::to_string(stats.hits)},
+                 {"Stat Index Hits", std::to_string(stats.stat_hits)},
+                 {"Persistent Store Hits", std::to_string(stats.store_hits)},
+                 {"Shared Cache Hits", std::to_string(stats.shared_hits)},
+                 {"Near Duplicate Hits", std::to_string(stats.near_hits)},
+                 {"In Flight Hits", std::to_string(stats.in_flight_hits)},
+                 {"Misses (OCR)", std::to_string(stats.misses)},
+                 {"Skipped (blank)", std::to_string(stats.skipped)},
+                 {"Adaptive First Pass", std::to_string(stats.first_pass)},
+                 {"Adaptive Second Pass",
+                  fmtstr("{0} ({1} regions)", stats.second_pass, stats.regions_rerun)},
+                 {"Timed Out", std::to_string(stats.timeouts)},
+                 {"Document Pages", std::to_string(stats.pages)},
+                 {"Duplicates by Hash", std::to_string(stats.duplicates)},
+                 {"Inserts", std::to_string(stats.inserts)},
+                 {"Evictions", std::to_string(stats.evictions)},
+                 {"Entries", fmtstr("{0} / {1}", stats.entries, stats.capacity)},
+                 {"Bytes Stored", fmtstr("{0:N} / {1:N}", stats.bytes_stored, stats.byte_budget)},
+                 {"Hit Ratio", fmtstr("{0:P}", stats.hitRatio())},
+                 {"Time Saved", fmtstr("{0:f2} ms", stats.time_saved_ms)}});
+        }
     };
 
 #pragma endregion
@@ -0,0 +1,54 @@
+// traineddata.h
+#ifndef TRAINEDDATA_H
+#define TRAINEDDATA_H
+
+#include <cstddef>
+#include <llvm/Support/Error.h>
+#include <memory>
+#include <string>
+
+#pragma region TRAINEDDATA_MAPPING        /* Memory Mapped Tesseract Models */
+
+/// @brief Read-only Memory Mapping of a <lang>.traineddata File, located once per Language and
+/// reused by every Pool - an Engine initialized from it skips the tessdata Search and File read.
+/// It does not share the Model: TessBaseAPI::Init copies the Buffer and every Engine still
+/// deserializes and holds its own Model, so Memory per Engine is unchanged.
+///
+/// @code{.cpp}
+///     auto modelOrErr = TrainedData::map("eng");
+///     if (modelOrErr) {
+///         api.Init((*modelOrErr)->data(), (*modelOrErr)->size(), "eng", ...);
+///     }
+/// @endcode
+class TrainedData {
+  public:
+    /// @brief Map the traineddata of a Language, reusing a live Mapping if one exists.
+    /// Searched in $TESSDATA_PREFIX, $TESSDATA_PREFIX/tessdata and the build time TESSDATA_PREFIX.
+    /// @param lang - single Tesseract Language Code such as "eng"
+    /// @return llvm::Expected<std::shared_ptr<const TrainedData>>
+    static auto map(const std::string &lang) -> llvm::Expected<std::shared_ptr<const TrainedData>>;
+
+    TrainedData(const TrainedData &)                     = delete;
+    TrainedData(TrainedData &&)                          = delete;
+    auto operator=(const TrainedData &) -> TrainedData & = delete;
+    auto operator=(TrainedData &&) -> TrainedData      & = delete;
+
+    ~TrainedData();
+
+    auto data() const -> const char * { return mapped; }
+
+    auto size() const -> std::size_t { return length; }
+
+    auto path() const -> const std::string & { return file_path; }
+
+  private:
+    TrainedData(std::string path, const char *mapped, std::size_t length);
+
+    std::string file_path;
+    const char *mapped = nullptr;
+    std::size_t length = 0;
+};
+
+#pragma endregion
+
+#endif // TRAINEDDATA_H
@@ -0,0 +1,160 @@
+// words.h
+#ifndef WORDS_H
+#define WORDS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <ktesseract.h>
+#include <memory>
+#include <optional>
+#include <pix.h>
+#include <string>
+#include <string_view>
+#include <tesseract/resultiterator.h>
+#include <vector>
+
+namespace imgstr {
+
+#pragma region WORD_RESULTS               /* Word level Results of a single Recognition */
+
+    /// @brief Pixel Bounds of a Word - right and bottom are exclusive as in Tesseract
+    struct WordBox {
+        int32_t left = 0, top = 0, right = 0, bottom = 0;
+    };
+
+    /// @brief Recognized Words of an Image as parallel Arrays. Word i spans chars[ends[i - 1],
+    /// ends[i]) and has boxes[i], confidences[i], line_ids[i] and block_ids[i]. Line and Block Ids
+    /// count from 0 in reading Order across the Page, so Words of one Line share a line_id.
+    struct OcrWords {
+        std::string           chars; // UTF-8 of all Words without Separators
+        std::vector<uint32_t> ends;
+        std::vector<WordBox>  boxes;
+        std::vector<float>    confidences; // 0 - 100
+        std::vector<uint32_t> line_ids;
+        std::vector<uint32_t> block_ids;
+        int32_t               page_width  = 0; // Pixels of the Image the Boxes refer to
+        int32_t               page_height = 0;
+
+        auto size() const -> std::size_t { return ends.size(); }
+
+        auto empty() const -> bool { return ends.empty(); }
+
+        auto word(std::size_t i) const -> std::string_view {
+            uint32_t begin = i == 0 ? 0 : ends[i - 1];
+            return std::string_view(chars).substr(begin, ends[i] - begin);
+        }
+
+        void push(std::string_view word, WordBox box, float conf, uint32_t line, uint32_t block) {
+            chars.append(word);
+            ends.push_back(static_cast<uint32_t>(chars.size()));
+            boxes.push_back(box);
+            confidences.push_back(conf);
+            line_ids.push_back(line);
+            block_ids.push_back(block);
+        }
+
+        /// @brief Map Boxes found on a rescaled Copy back to the Pixels of the original Image
+        /// @param sx - original Width / recognized Width
+        /// @param sy - original Height / recognized Height
+        void scale(float sx, float sy) {
+            page_width  = static_cast<int32_t>(page_width * sx);
+            page_height = static_cast<int32_t>(page_height * sy);
+            for (auto &box: boxes) {
+                box.left   = static_cast<int32_t>(box.left * sx);
+                box.top    = static_cast<int32_t>(box.top * sy);
+                box.right  = static_cast<int32_t>(box.right * sx);
+                box.bottom = static_cast<int32_t>(box.bottom * sy);
+            }
+        }
+
+        /// @brief Approximate Bytes held - counted against the Cache Byte Budget
+        auto footprint() const -> std::size_t {
+            return chars.capacity() + ends.capacity() * sizeof(uint32_t) +
+                   boxes.capacity() * sizeof(WordBox) + confidences.capacity() * sizeof(float) +
+                   line_ids.capacity() * sizeof(uint32_t) + block_ids.capacity() * sizeof(uint32_t);
+        }
+    };
+
+    /// @brief Text and Words of one Recognition
+    struct OcrResult {
+        std::string text;
+        OcrWords    words;
+    };
+
+    /// @brief Collect every Word of the last Recognition in one ResultIterator Walk
+    /// @param engine - after Recognize()
+    /// @return OcrWords - empty if nothing was recognized
+    inline auto readWords(tesseract::TessBaseAPI &engine) -> OcrWords {
+        OcrWords                                   words;
+        std::unique_ptr<tesseract::ResultIterator> it(engine.GetIterator());
+
+        if (!it || it->Empty(tesseract::RIL_WORD)) {
+            return words;
+        }
+
+        uint32_t line  = 0;
+        uint32_t block = 0;
+        bool     first = true;
+
+        do {
+            if (!first) {
+                if (it->IsAtBeginningOf(tesseract::RIL_BLOCK)) {
+                    ++block;
+                    ++line;
+                } else if (it->IsAtBeginningOf(tesseract::RIL_TEXTLINE)) {
+                    ++line;
+                }
+            }
+            first = false;
+
+            std::unique_ptr<char[]> text(it->GetUTF8Text(tesseract::RIL_WORD));
+            if (!text) {
+                continue;
+            }
+
+            WordBox box;
+            it->BoundingBox(tesseract::RIL_WORD, &box.left, &box.top, &box.right, &box.bottom);
+
+            words.push(text.get(), box, it->Confidence(tesseract::RIL_WORD), line, block);
+        } while (it->Next(tesseract::RIL_WORD));
+
+        return words;
+    }
+
+    /// @brief Recognize once and return both the Text and its Words - Consumers that need
+    /// Positions, e.g. Search Highlighting, do not have to run a second OCR Pass.
+    /// @param pool
+    /// @param image
+    /// @param img_mode
+    /// @param deadline - see recognizeWithin()
+    /// @return OcrResult - Boxes in Pixels of image
+    /// @throws OcrTimeoutError if the Deadline passes first
+    inline auto getTextOCRWords(TesseractPool             &pool,
+                                Pix                       *image,
+                                ImgMode                    img_mode = ImgMode::document,
+                                std::optional<OcrDeadline> deadline = std::nullopt)
+        -> OcrResult {
+        auto engine = pool.acquire();
+
+        engine->SetPageSegMode(engineProfile(pool.ocrProfile()).pageSegMode(img_mode));
+        engine->SetImage(image);
+
+        recognizeWithin(*engine, deadline);
+
+        OcrResult               result;
+        std::unique_ptr<char[]> rawText(engine->GetUTF8Text());
+        if (rawText) {
+            result.text = rawText.get();
+        }
+        result.words             = readWords(*engine);
+        result.words.page_width  = pixGetWidth(image);
+        result.words.page_height = pixGetHeight(image);
+
+        return result;
+    }
+
+#pragma endregion
+
+} // namespace imgstr
+
+#endif // WORDS_H
@@ -1,12 +1,14 @@
 #include <array>
 #include <conversion.h>
 #include <iostream>
+#include <ktesseract.h>
 #include <leptonica/allheaders.h>
 #include <llvm/Support/raw_ostream.h>
 #include <ostream>
 #include <string>
 #include <tesseract/baseapi.h>
 #include <tesseract/renderer.h>
+#include <thread>
 #include <unistd.h>
 
 /// @brief Get the current Location and Print
@@ -108,23 +110,13 @@ auto extractTextFromImageFileLeptonica(const std::string &file_path,
 /// @param lang
 /// @return std::string
 auto extractTextLSTM(const std::string &file_path, const std::string &lang) -> std::string {
-    auto *api = new tesseract::TessBaseAPI();
-    if (api->Init(nullptr, "eng", tesseract::OEM_LSTM_ONLY) != 0) {
-        fprintf(stderr, "Could not initialize tesseract.\n");
-        exit(1);
-    }
-    Pix *image = pixRead(file_path.c_str());
+    // LSTM only Engines are the fast Profile - pooled and reused across Calls and Threads
+    static LanguagePools pools(std::max(1U, std::thread::hardware_concurrency()));
 
-    api->SetImage(image);
-
-    // Get the text from the image.
-    char       *rawText = api->GetUTF8Text();
-    std::string outText(rawText);
-
-    delete[] rawText; // Free the memory allocated by GetUTF8Text
+    PixPtr image(pixRead(file_path.c_str()));
+    if (!image) {
+        throw std::runtime_error("Failed to load image: " + file_path);
+    }
 
-    api->End();
-    delete api;
-    pixDestroy(&image);
-    return outText;
+    return getTextOCR(pools.get(lang, OcrProfile::fast), image.get());
 }
@@ -0,0 +1,281 @@
+#include "shmcache.h"
+#include <array>
+#include <cstring>
+#include <fcntl.h>
+#include <llvm/Support/FormatVariadic.h>
+#include <llvm/Support/MathExtras.h>
+#include <new>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <thread>
+#include <unistd.h>
+
+namespace imgstr {
+
+    namespace {
+        constexpr std::array<char, 8> kShmMagic   = {'K', 'I', 'M', 'G', 'S', 'H', 'M', 'C'};
+        constexpr uint32_t            kShmVersion = 1;
+
+        // Slot States
+        constexpr uint32_t kEmpty   = 0;
+        constexpr uint32_t kWriting = 1; // claimed, Digest and Text not yet visible
+        constexpr uint32_t kReady   = 2;
+
+        // a Slot left in kWriting by a crashed Writer is skipped after this many polls
+        constexpr int kWritingSpins = 1024;
+
+        static_assert(std::atomic<uint32_t>::is_always_lock_free &&
+                          std::atomic<uint64_t>::is_always_lock_free,
+                      "Shared Memory Atomics must be lock-free to be address-free");
+
+        auto errnoError(const std::string &msg) -> llvm::Error {
+            std::error_code ERR(errno, std::generic_category());
+            return llvm::make_error<llvm::StringError>(msg + ": " + ERR.message(), ERR);
+        }
+
+        /// @brief Reserve `size` Bytes at the Arena Tail - never moves the Tail past the Limit
+        /// @return bool - false if the Bytes do not fit
+        auto reserveArena(std::atomic<uint64_t> &tail, uint64_t limit, uint64_t size,
+                          uint64_t &offset) -> bool {
+            offset = tail.load(std::memory_order_relaxed);
+            do {
+                if (offset > limit || size > limit - offset) {
+                    return false;
+                }
+            } while (!tail.compare_exchange_weak(offset, offset + size, std::memory_order_relaxed));
+            return true;
+        }
+
+        /// @brief Hand an unused Reservation back - only possible while it is still the last one,
+        /// a Reservation followed by another Writer's stays unused Arena Space
+        void releaseArena(std::atomic<uint64_t> &tail, uint64_t offset, uint64_t size) {
+            uint64_t end = offset + size;
+            tail.compare_exchange_strong(end, offset, std::memory_order_relaxed);
+        }
+
+        /// @brief flock() held for the Scope - serializes creation of the File across Processes
+        struct FileLock {
+            int fd;
+
+            explicit FileLock(int fd): fd(fd) { ::flock(fd, LOCK_EX); }
+
+            ~FileLock() { ::flock(fd, LOCK_UN); }
+        };
+    } // namespace
+
+    struct alignas(64) SharedMemoryCache::Header {
+        std::array<char, 8>   magic;
+        uint32_t              version;
+        uint32_t              reserved;
+        uint64_t              slot_count;
+        uint64_t              arena_bytes;
+        std::atomic<uint64_t> arena_tail;
+        std::atomic<uint64_t> entries;
+    };
+
+    struct SharedMemoryCache::Slot {
+        std::atomic<uint32_t> state;
+        uint32_t              text_size;
+        uint64_t              text_offset;
+        uint8_t               hash[Sha256Digest::SIZE];
+    };
+
+    SharedMemoryCache::SharedMemoryCache(std::string path, int fd)
+        : file_path(std::move(path)),
+          fd(fd) {}
+
+    SharedMemoryCache::~SharedMemoryCache() {
+        if (mapped != nullptr) {
+            ::munmap(mapped, map_length);
+        }
+        if (fd >= 0) {
+            ::close(fd);
+        }
+    }
+
+    auto SharedMemoryCache::open(const std::string &path, uint64_t slot_count, uint64_t arena_bytes)
+        -> llvm::Expected<std::unique_ptr<SharedMemoryCache>> {
+        static_assert(sizeof(Header) == 64, "Header must fill one Cache Line");
+        static_assert(sizeof(Slot) == 48, "Slot must be tightly packed");
+
+        int fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+        if (fd < 0) {
+            return errnoError("Failed to open Shared Cache " + path);
+        }
+
+        std::unique_ptr<SharedMemoryCache> shm(new SharedMemoryCache(path, fd));
+
+        FileLock lock(fd);
+
+        struct stat st {};
+        if (::fstat(fd, &st) != 0) {
+            return errnoError("Failed to stat Shared Cache " + path);
+        }
+
+        if (st.st_size == 0) {
+            slot_count      = llvm::PowerOf2Ceil(std::max<uint64_t>(slot_count, 2));
+            uint64_t length = sizeof(Header) + slot_count * sizeof(Slot) + arena_bytes;
+
+            // ftruncate zero fills - every Slot starts out kEmpty
+            if (::ftruncate(fd, static_cast<off_t>(length)) != 0) {
+                return errnoError("Failed to size Shared Cache " + path);
+            }
+            if (auto err = shm->map(length)) {
+                return std::move(err);
+            }
+
+            // other Processes wait on the flock() and never observe a partial Header
+            auto *header        = new (shm->mapped) Header {};
+            header->magic       = kShmMagic;
+            header->version     = kShmVersion;
+            header->slot_count  = slot_count;
+            header->arena_bytes = arena_bytes;
+
+            return shm;
+        }
+
+        Header header {};
+        if (::pread(fd, &header, sizeof(header), 0) != sizeof(header) ||
+            header.magic != kShmMagic || header.version != kShmVersion) {
+            return llvm::make_error<llvm::StringError>(
+                llvm::formatv("{0} is not a textract Shared Cache (version {1})", path, kShmVersion)
+                    .str(),
+                std::make_error_code(std::errc::invalid_argument));
+        }
+
+        uint64_t length = sizeof(Header) + header.slot_count * sizeof(Slot) + header.arena_bytes;
+        if (static_cast<uint64_t>(st.st_size) < length) {
+            return llvm::make_error<llvm::StringError>(
+                llvm::formatv("Shared Cache {0} is truncated", path).str(),
+                std::make_error_code(std::errc::invalid_argument));
+        }
+
+        if (auto err = shm->map(length)) {
+            return std::move(err);
+        }
+
+        return shm;
+    }
+
+    auto SharedMemoryCache::map(uint64_t length) -> llvm::Error {
+        void *region = ::mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        if (region == MAP_FAILED) {
+            return errnoError("Failed to memory map Shared Cache " + file_path);
+        }
+        mapped     = static_cast<char *>(region);
+        map_length = length;
+        return llvm::Error::success();
+    }
+
+    auto SharedMemoryCache::slots() const -> Slot * {
+        return reinterpret_cast<Slot *>(mapped + sizeof(Header));
+    }
+
+    auto SharedMemoryCache::arena() const -> char * {
+        const auto *header = reinterpret_cast<const Header *>(mapped);
+        return mapped + sizeof(Header) + header->slot_count * sizeof(Slot);
+    }
+
+    /// @brief Text published for the Digest by any Process
+    /// @param hash
+    /// @return std::optional<std::string>
+    auto SharedMemoryCache::lookup(const Sha256Digest &hash) const -> std::optional<std::string> {
+        const auto *header = reinterpret_cast<const Header *>(mapped);
+        uint64_t    mask   = header->slot_count - 1;
+        uint64_t    start  = DigestHasher {}(hash) & mask;
+
+        for (uint64_t probe = 0; probe <= mask; ++probe) {
+            Slot    &slot  = slots()[(start + probe) & mask];
+            uint32_t state = slot.state.load(std::memory_order_acquire);
+
+            if (state == kEmpty) {
+                return std::nullopt;
+            }
+
+            // a Slot being written may hold this Digest - reporting a miss only costs an OCR
+            if (state == kReady && std::memcmp(slot.hash, hash.data(), Sha256Digest::SIZE) == 0) {
+                // the File is writable by every Process - a corrupt Slot is a miss, not a read
+                // past the Mapping
+                uint64_t offset = slot.text_offset;
+                uint64_t size   = slot.text_size;
+                if (offset > header->arena_bytes || size > header->arena_bytes - offset) {
+                    return std::nullopt;
+                }
+                return std::string(arena() + offset, size);
+            }
+        }
+
+        return std::nullopt;
+    }
+
+    /// @brief Publish the Text for a Digest
+    /// @param hash
+    /// @param text
+    /// @return bool - false if the Table or Arena is full. An existing Entry counts as success.
+    auto SharedMemoryCache::insert(const Sha256Digest &hash, const std::string &text) -> bool {
+        auto    *header = reinterpret_cast<Header *>(mapped);
+        uint64_t mask   = header->slot_count - 1;
+        uint64_t start  = DigestHasher {}(hash) & mask;
+
+        uint64_t offset   = 0;
+        bool     reserved = false;
+
+        for (uint64_t probe = 0; probe <= mask; ++probe) {
+            Slot    &slot  = slots()[(start + probe) & mask];
+            uint32_t state = slot.state.load(std::memory_order_acquire);
+
+            if (state == kEmpty) {
+                // the Text is reserved before a Slot is claimed - a full Arena must not leave a
+                // claimed Slot behind, lookups stop at the first kEmpty Slot
+                if (!reserved) {
+                    if (!reserveArena(
+                            header->arena_tail, header->arena_bytes, text.size(), offset)) {
+                        return false;
+                    }
+                    reserved = true;
+                }
+
+                // a lost Race leaves the Reservation for the next kEmpty Slot
+                if (slot.state.compare_exchange_strong(
+                        state, kWriting, std::memory_order_acq_rel)) {
+                    std::memcpy(slot.hash, hash.data(), Sha256Digest::SIZE);
+                    std::memcpy(arena() + offset, text.data(), text.size());
+                    slot.text_offset = offset;
+                    slot.text_size   = static_cast<uint32_t>(text.size());
+                    slot.state.store(kReady, std::memory_order_release);
+
+                    header->entries.fetch_add(1, std::memory_order_relaxed);
+                    return true;
+                }
+            }
+
+            // another Writer owns the Slot - it may be publishing this very Digest
+            for (int spin = 0; state == kWriting && spin < kWritingSpins; ++spin) {
+                std::this_thread::yield();
+                state = slot.state.load(std::memory_order_acquire);
+            }
+
+            if (state == kReady && std::memcmp(slot.hash, hash.data(), Sha256Digest::SIZE) == 0) {
+                if (reserved) {
+                    releaseArena(header->arena_tail, offset, text.size());
+                }
+                return true;
+            }
+        }
+
+        if (reserved) {
+            releaseArena(header->arena_tail, offset, text.size());
+        }
+        return false;
+    }
+
+    auto SharedMemoryCache::size() const -> uint64_t {
+        return reinterpret_cast<const Header *>(mapped)->entries.load(std::memory_order_relaxed);
+    }
+
+    auto SharedMemoryCache::capacity() const -> uint64_t {
+        return reinterpret_cast<const Header *>(mapped)->slot_count;
+    }
+
+} // namespace imgstr
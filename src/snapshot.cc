@@ -0,0 +1,287 @@
+#include "snapshot.h"
+#include <array>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <llvm/ADT/ArrayRef.h>
+#include <llvm/ADT/StringRef.h>
+#include <llvm/Support/CRC.h>
+#include <llvm/Support/FormatVariadic.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace imgstr {
+
+    namespace {
+        constexpr std::array<char, 8> kSnapshotMagic   = {'K', 'I', 'M', 'G', 'S', 'N', 'A', 'P'};
+        constexpr uint32_t            kSnapshotVersion = 2; // 2 - Skipped, Profile and Language
+        constexpr size_t              kFlushThreshold  = 1 << 20;
+
+        constexpr uint32_t kFlagTextCompressed = 1U << 0;
+        constexpr uint32_t kFlagOutputWritten  = 1U << 1;
+        constexpr uint32_t kFlagSkipped        = 1U << 2;
+        constexpr uint32_t kProfileShift       = 8; // OcrProfile in Bits 8-15 of the Flags
+        constexpr uint32_t kProfileMask        = 0xFF;
+
+        constexpr auto kLastProfile = static_cast<uint32_t>(OcrProfile::accurate);
+        constexpr auto kLastLang    = static_cast<uint32_t>(ISOLang::de);
+
+        struct SnapshotHeader {
+            std::array<char, 8> magic;
+            uint32_t            version;
+            uint32_t            checksum; // CRC32 of everything following the Header
+            uint64_t            entry_count;
+            uint64_t            body_size;
+        };
+
+        struct EntryHeader {
+            uint32_t uri_size;
+            uint32_t text_size;
+            uint32_t time_size;
+            uint32_t fuzzhash_size;
+            uint32_t output_path_size;
+            uint32_t write_timestamp_size;
+            uint32_t flags;
+            uint32_t lang; // ISOLang
+            uint64_t original_text_size;
+            uint64_t image_size;
+        };
+
+        static_assert(sizeof(SnapshotHeader) == 32, "SnapshotHeader must be tightly packed");
+        static_assert(sizeof(EntryHeader) == 48, "EntryHeader must be tightly packed");
+
+        auto payloadSize(const EntryHeader &header) -> uint64_t {
+            return static_cast<uint64_t>(Sha256Digest::SIZE) + header.uri_size + header.text_size +
+                   header.time_size + header.fuzzhash_size + header.output_path_size +
+                   header.write_timestamp_size;
+        }
+
+        auto errnoError(const std::string &msg) -> llvm::Error {
+            std::error_code ERR(errno, std::generic_category());
+            return llvm::make_error<llvm::StringError>(msg + ": " + ERR.message(), ERR);
+        }
+
+        auto corruptError(const std::string &path, const char *reason) -> llvm::Error {
+            return llvm::make_error<llvm::StringError>(
+                llvm::formatv("{0} is not a valid Cache Snapshot: {1}", path, reason).str(),
+                std::make_error_code(std::errc::invalid_argument));
+        }
+
+        auto writeAll(int fd, const char *data, size_t size) -> bool {
+            while (size > 0) {
+                ssize_t written = ::write(fd, data, size);
+                if (written < 0) {
+                    if (errno == EINTR) {
+                        continue;
+                    }
+                    return false;
+                }
+                data += written;
+                size -= static_cast<size_t>(written);
+            }
+            return true;
+        }
+
+        void appendEntry(std::string &buffer, const SnapshotEntry &entry) {
+            EntryHeader header {};
+            header.uri_size             = static_cast<uint32_t>(entry.uri.size());
+            header.text_size            = static_cast<uint32_t>(entry.text.size());
+            header.time_size            = static_cast<uint32_t>(entry.time_processed.size());
+            header.fuzzhash_size        = static_cast<uint32_t>(entry.fuzzhash.size());
+            header.output_path_size     = static_cast<uint32_t>(entry.output_path.size());
+            header.write_timestamp_size = static_cast<uint32_t>(entry.write_timestamp.size());
+            header.flags                = (entry.text_compressed ? kFlagTextCompressed : 0) |
+                           (entry.output_written ? kFlagOutputWritten : 0) |
+                           (entry.skipped ? kFlagSkipped : 0) |
+                           (static_cast<uint32_t>(entry.profile) << kProfileShift);
+            header.lang                 = static_cast<uint32_t>(entry.lang);
+            header.original_text_size   = entry.text_size;
+            header.image_size           = entry.image_size;
+
+            buffer.append(reinterpret_cast<const char *>(&header), sizeof(header))
+                .append(entry.hash.view().data(), Sha256Digest::SIZE)
+                .append(entry.uri)
+                .append(entry.text)
+                .append(entry.time_processed)
+                .append(entry.fuzzhash)
+                .append(entry.output_path)
+                .append(entry.write_timestamp);
+        }
+
+        /// @brief RAII Mapping of a whole File - unmapped and closed on Scope exit
+        struct MappedFile {
+            int         fd     = -1;
+            const char *data   = nullptr;
+            uint64_t    length = 0;
+
+            ~MappedFile() {
+                if (data != nullptr) {
+                    ::munmap(const_cast<char *>(data), length);
+                }
+                if (fd >= 0) {
+                    ::close(fd);
+                }
+            }
+        };
+    } // namespace
+
+    auto writeSnapshot(const std::string &path, const std::vector<SnapshotEntry> &entries)
+        -> llvm::Error {
+        std::string tmp_path = path + ".tmp";
+
+        int fd = ::open(tmp_path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+        if (fd < 0) {
+            return errnoError("Failed to create Cache Snapshot " + tmp_path);
+        }
+
+        auto fail = [&](const std::string &msg) {
+            auto err = errnoError(msg);
+            ::close(fd);
+            ::unlink(tmp_path.c_str());
+            return err;
+        };
+
+        SnapshotHeader header {kSnapshotMagic, kSnapshotVersion, 0, entries.size(), 0};
+
+        if (!writeAll(fd, reinterpret_cast<const char *>(&header), sizeof(header))) {
+            return fail("Failed to write Cache Snapshot " + tmp_path);
+        }
+
+        std::string buffer;
+        buffer.reserve(kFlushThreshold * 2);
+
+        auto flush = [&]() -> bool {
+            const auto *bytes = reinterpret_cast<const uint8_t *>(buffer.data());
+            header.checksum   = llvm::crc32(header.checksum,
+                                          llvm::ArrayRef<uint8_t>(bytes, buffer.size()));
+            header.body_size += buffer.size();
+
+            bool written = writeAll(fd, buffer.data(), buffer.size());
+            buffer.clear();
+            return written;
+        };
+
+        for (const auto &entry: entries) {
+            appendEntry(buffer, entry);
+            if (buffer.size() >= kFlushThreshold && !flush()) {
+                return fail("Failed to write Cache Snapshot " + tmp_path);
+            }
+        }
+
+        if (!flush() || ::pwrite(fd, &header, sizeof(header), 0) != sizeof(header) ||
+            ::fsync(fd) != 0) {
+            return fail("Failed to write Cache Snapshot " + tmp_path);
+        }
+
+        ::close(fd);
+
+        if (std::rename(tmp_path.c_str(), path.c_str()) != 0) {
+            auto err = errnoError("Failed to replace Cache Snapshot " + path);
+            ::unlink(tmp_path.c_str());
+            return err;
+        }
+
+        return llvm::Error::success();
+    }
+
+    auto readSnapshot(const std::string &path) -> llvm::Expected<std::vector<SnapshotEntry>> {
+        MappedFile file;
+
+        file.fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (file.fd < 0) {
+            return errnoError("Failed to open Cache Snapshot " + path);
+        }
+
+        struct stat st {};
+        if (::fstat(file.fd, &st) != 0) {
+            return errnoError("Failed to stat Cache Snapshot " + path);
+        }
+
+        auto file_size = static_cast<uint64_t>(st.st_size);
+        if (file_size < sizeof(SnapshotHeader)) {
+            return corruptError(path, "missing header");
+        }
+
+        void *region = ::mmap(nullptr, file_size, PROT_READ, MAP_PRIVATE, file.fd, 0);
+        if (region == MAP_FAILED) {
+            return errnoError("Failed to memory map Cache Snapshot " + path);
+        }
+        file.data   = static_cast<const char *>(region);
+        file.length = file_size;
+
+        ::madvise(region, file_size, MADV_SEQUENTIAL);
+
+        SnapshotHeader header {};
+        std::memcpy(&header, file.data, sizeof(header));
+
+        if (header.magic != kSnapshotMagic || header.version != kSnapshotVersion) {
+            return corruptError(path, "unknown format or version");
+        }
+
+        if (header.body_size != file_size - sizeof(SnapshotHeader)) {
+            return corruptError(path, "truncated");
+        }
+
+        llvm::StringRef body(file.data + sizeof(SnapshotHeader), header.body_size);
+
+        if (llvm::crc32(llvm::ArrayRef<uint8_t>(body.bytes_begin(), body.size())) !=
+            header.checksum) {
+            return corruptError(path, "checksum mismatch");
+        }
+
+        constexpr uint64_t kMinEntrySize = sizeof(EntryHeader) + Sha256Digest::SIZE;
+        if (header.entry_count > header.body_size / kMinEntrySize) {
+            return corruptError(path, "entry count exceeds body");
+        }
+
+        std::vector<SnapshotEntry> entries;
+        entries.reserve(header.entry_count);
+
+        auto take = [&body](uint64_t size) {
+            llvm::StringRef field = body.take_front(size);
+            body                  = body.drop_front(size);
+            return field.str();
+        };
+
+        for (uint64_t i = 0; i < header.entry_count; ++i) {
+            EntryHeader entry_header {};
+            if (body.size() < sizeof(entry_header)) {
+                return corruptError(path, "entry header out of bounds");
+            }
+            std::memcpy(&entry_header, body.data(), sizeof(entry_header));
+            body = body.drop_front(sizeof(entry_header));
+
+            if (payloadSize(entry_header) > body.size()) {
+                return corruptError(path, "entry out of bounds");
+            }
+
+            uint32_t profile = (entry_header.flags >> kProfileShift) & kProfileMask;
+            if (profile > kLastProfile || entry_header.lang > kLastLang) {
+                return corruptError(path, "unknown language or profile");
+            }
+
+            SnapshotEntry entry;
+            entry.hash            = *Sha256Digest::fromBytes(body.take_front(Sha256Digest::SIZE));
+            body                  = body.drop_front(Sha256Digest::SIZE);
+            entry.uri             = take(entry_header.uri_size);
+            entry.text            = take(entry_header.text_size);
+            entry.time_processed  = take(entry_header.time_size);
+            entry.fuzzhash        = take(entry_header.fuzzhash_size);
+            entry.output_path     = take(entry_header.output_path_size);
+            entry.write_timestamp = take(entry_header.write_timestamp_size);
+            entry.text_size       = entry_header.original_text_size;
+            entry.image_size      = entry_header.image_size;
+            entry.text_compressed = (entry_header.flags & kFlagTextCompressed) != 0;
+            entry.output_written  = (entry_header.flags & kFlagOutputWritten) != 0;
+            entry.skipped         = (entry_header.flags & kFlagSkipped) != 0;
+            entry.profile         = static_cast<OcrProfile>(profile);
+            entry.lang            = static_cast<ISOLang>(entry_header.lang);
+
+            entries.push_back(std::move(entry));
+        }
+
+        return entries;
+    }
+
+} // namespace imgstr
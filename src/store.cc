@@ -0,0 +1,316 @@
+#include "store.h"
+#include "util.h"
+#include <array>
+#include <cstring>
+#include <fcntl.h>
+#include <llvm/ADT/ArrayRef.h>
+#include <llvm/Support/CRC.h>
+#include <llvm/Support/FormatVariadic.h>
+#include <mutex>
+#include <shared_mutex>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace imgstr {
+
+    namespace {
+        constexpr std::array<char, 8> kFileMagic   = {'K', 'I', 'M', 'G', 'S', 'T', 'O', 'R'};
+        constexpr uint32_t            kFileVersion = 2;
+        constexpr uint32_t            kRecordMagic = 0x4B494D47; // "KIMG"
+
+        struct FileHeader {
+            std::array<char, 8> magic;
+            uint32_t            version;
+            uint32_t            reserved;
+        };
+
+        struct RecordHeader {
+            uint32_t magic;
+            uint32_t hash_size;
+            uint32_t uri_size;
+            uint32_t text_size;
+            uint32_t fuzzhash_size;
+            uint32_t checksum; // CRC32 of the payload - detects torn appends
+            uint64_t image_size;
+        };
+
+        static_assert(sizeof(FileHeader) == 16, "FileHeader must be tightly packed");
+        static_assert(sizeof(RecordHeader) == 32, "RecordHeader must be tightly packed");
+
+        auto payloadSize(const RecordHeader &header) -> uint64_t {
+            return static_cast<uint64_t>(header.hash_size) + header.uri_size + header.text_size +
+                   header.fuzzhash_size;
+        }
+
+        auto errnoError(const std::string &msg) -> llvm::Error {
+            std::error_code ERR(errno, std::generic_category());
+            return llvm::make_error<llvm::StringError>(msg + ": " + ERR.message(), ERR);
+        }
+
+        auto writeAll(int fd, const char *data, size_t size) -> bool {
+            while (size > 0) {
+                ssize_t written = ::write(fd, data, size);
+                if (written < 0) {
+                    if (errno == EINTR) {
+                        continue;
+                    }
+                    return false;
+                }
+                data += written;
+                size -= static_cast<size_t>(written);
+            }
+            return true;
+        }
+    } // namespace
+
+    ImageStore::ImageStore(std::string path, int fd): file_path(std::move(path)), fd(fd) {}
+
+    ImageStore::~ImageStore() {
+        if (mapped != nullptr) {
+            ::munmap(const_cast<char *>(mapped), map_length);
+        }
+        if (fd >= 0) {
+            ::close(fd);
+        }
+    }
+
+    /// @brief Open or Create a Store at the Path and Index all valid Records
+    /// @param path
+    /// @return llvm::Expected<std::unique_ptr<ImageStore>>
+    auto ImageStore::open(const std::string &path) -> llvm::Expected<std::unique_ptr<ImageStore>> {
+        int fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+        if (fd < 0) {
+            return errnoError("Failed to open Image Store " + path);
+        }
+
+        std::unique_ptr<ImageStore> store(new ImageStore(path, fd));
+
+        // end_offset and the Index are private to this Object - a second writer on the same File
+        // would append over our Records, so the Store is owned exclusively while open
+        if (::flock(fd, LOCK_EX | LOCK_NB) != 0) {
+            if (errno == EWOULDBLOCK) {
+                return llvm::make_error<llvm::StringError>(
+                    "Image Store " + path + " is already open in another Processor or Process",
+                    std::make_error_code(std::errc::device_or_resource_busy));
+            }
+            return errnoError("Failed to lock Image Store " + path);
+        }
+
+        if (auto err = store->load()) {
+            return std::move(err);
+        }
+
+        return store;
+    }
+
+    /// @brief Map the existing File, validate the Header and Index every intact Record. Anything
+    /// following the first invalid Record is a torn append and is truncated.
+    auto ImageStore::load() -> llvm::Error {
+        struct stat st {};
+        if (::fstat(fd, &st) != 0) {
+            return errnoError("Failed to stat Image Store " + file_path);
+        }
+
+        auto file_size = static_cast<uint64_t>(st.st_size);
+
+        if (file_size > 0 && file_size < sizeof(FileHeader)) {
+            return llvm::make_error<llvm::StringError>(
+                llvm::formatv("{0} is not a textract Image Store ({1} bytes, header needs {2})",
+                              file_path,
+                              file_size,
+                              sizeof(FileHeader))
+                    .str(),
+                std::make_error_code(std::errc::invalid_argument));
+        }
+
+        if (file_size == 0) {
+            FileHeader header {kFileMagic, kFileVersion, 0};
+            if (::ftruncate(fd, 0) != 0 ||
+                !writeAll(fd, reinterpret_cast<const char *>(&header), sizeof(header))) {
+                return errnoError("Failed to initialize Image Store " + file_path);
+            }
+            end_offset = sizeof(FileHeader);
+            return llvm::Error::success();
+        }
+
+        void *region = ::mmap(nullptr, file_size, PROT_READ, MAP_SHARED, fd, 0);
+        if (region == MAP_FAILED) {
+            return errnoError("Failed to memory map Image Store " + file_path);
+        }
+        mapped      = static_cast<const char *>(region);
+        map_length  = file_size;
+        mapped_size = file_size;
+
+        FileHeader header {};
+        std::memcpy(&header, mapped, sizeof(header));
+        if (header.magic != kFileMagic || header.version != kFileVersion) {
+            return llvm::make_error<llvm::StringError>(
+                llvm::formatv("{0} is not a textract Image Store (version {1})",
+                              file_path,
+                              kFileVersion)
+                    .str(),
+                std::make_error_code(std::errc::invalid_argument));
+        }
+
+        uint64_t offset = sizeof(FileHeader);
+
+        while (offset + sizeof(RecordHeader) <= file_size) {
+            RecordHeader record {};
+            std::memcpy(&record, mapped + offset, sizeof(record));
+
+            uint64_t payload = payloadSize(record);
+            if (record.magic != kRecordMagic ||
+                payload > file_size - offset - sizeof(RecordHeader)) {
+                break;
+            }
+
+            const auto *data = reinterpret_cast<const uint8_t *>(mapped + offset +
+                                                                 sizeof(RecordHeader));
+            if (llvm::crc32(llvm::ArrayRef<uint8_t>(data, payload)) != record.checksum) {
+                break;
+            }
+
+            auto digest = Sha256Digest::fromBytes(
+                llvm::StringRef(mapped + offset + sizeof(RecordHeader), record.hash_size));
+            if (!digest) {
+                break;
+            }
+
+            index[*digest] = offset;
+            offset += sizeof(RecordHeader) + payload;
+        }
+
+        if (offset != file_size) {
+            serrfmt("Image Store {0}: dropping {1} bytes of torn trailing data\n",
+                    file_path,
+                    file_size - offset);
+            if (::ftruncate(fd, static_cast<off_t>(offset)) != 0) {
+                return errnoError("Failed to truncate Image Store " + file_path);
+            }
+            mapped_size = offset;
+        }
+
+        end_offset = offset;
+        return llvm::Error::success();
+    }
+
+    auto ImageStore::readAt(uint64_t offset, size_t length, char *dst) const -> bool {
+        if (offset + length <= mapped_size) {
+            std::memcpy(dst, mapped + offset, length);
+            return true;
+        }
+        while (length > 0) {
+            ssize_t got = ::pread(fd, dst, length, static_cast<off_t>(offset));
+            if (got < 0 && errno == EINTR) {
+                continue;
+            }
+            if (got <= 0) {
+                return false;
+            }
+            dst += got;
+            offset += static_cast<uint64_t>(got);
+            length -= static_cast<size_t>(got);
+        }
+        return true;
+    }
+
+    auto ImageStore::readRecord(uint64_t offset) const -> std::optional<StoreRecord> {
+        RecordHeader header {};
+        if (!readAt(offset, sizeof(header), reinterpret_cast<char *>(&header))) {
+            return std::nullopt;
+        }
+
+        std::string payload(payloadSize(header), '\0');
+        if (!readAt(offset + sizeof(header), payload.size(), payload.data())) {
+            return std::nullopt;
+        }
+
+        llvm::StringRef view(payload);
+
+        auto digest = Sha256Digest::fromBytes(view.substr(0, header.hash_size));
+        if (!digest) {
+            return std::nullopt;
+        }
+
+        StoreRecord record;
+        record.hash     = *digest;
+        view            = view.drop_front(header.hash_size);
+        record.uri      = view.substr(0, header.uri_size).str();
+        view            = view.drop_front(header.uri_size);
+        record.text     = view.substr(0, header.text_size).str();
+        view            = view.drop_front(header.text_size);
+        record.fuzzhash = view.substr(0, header.fuzzhash_size).str();
+
+        record.image_size = header.image_size;
+        return record;
+    }
+
+    /// @brief Retrieve the latest Record stored for a Hash
+    /// @param hash
+    /// @return std::optional<StoreRecord>
+    auto ImageStore::lookup(const Sha256Digest &hash) const -> std::optional<StoreRecord> {
+        uint64_t offset = 0;
+        {
+            std::shared_lock<folly::SharedMutex> readerLock(mutex);
+            auto                                 it = index.find(hash);
+            if (it == index.end()) {
+                return std::nullopt;
+            }
+            offset = it->second;
+        }
+        return readRecord(offset);
+    }
+
+    auto ImageStore::contains(const Sha256Digest &hash) const -> bool {
+        std::shared_lock<folly::SharedMutex> readerLock(mutex);
+        return index.find(hash) != index.end();
+    }
+
+    /// @brief Append a Record - written with a single write() so concurrent readers never
+    /// observe a partial Record
+    /// @param record
+    /// @return llvm::Error
+    auto ImageStore::append(const StoreRecord &record) -> llvm::Error {
+        RecordHeader header {};
+        header.magic         = kRecordMagic;
+        header.hash_size     = static_cast<uint32_t>(Sha256Digest::SIZE);
+        header.uri_size      = static_cast<uint32_t>(record.uri.size());
+        header.text_size     = static_cast<uint32_t>(record.text.size());
+        header.fuzzhash_size = static_cast<uint32_t>(record.fuzzhash.size());
+        header.image_size    = record.image_size;
+
+        std::string buffer(sizeof(RecordHeader), '\0');
+        buffer.reserve(sizeof(RecordHeader) + payloadSize(header));
+        buffer.append(record.hash.view().data(), Sha256Digest::SIZE)
+            .append(record.uri)
+            .append(record.text)
+            .append(record.fuzzhash);
+
+        const auto *payload = reinterpret_cast<const uint8_t *>(buffer.data() + sizeof(header));
+        header.checksum =
+            llvm::crc32(llvm::ArrayRef<uint8_t>(payload, buffer.size() - sizeof(header)));
+        std::memcpy(buffer.data(), &header, sizeof(header));
+
+        std::unique_lock<folly::SharedMutex> writerLock(mutex);
+
+        if (!writeAll(fd, buffer.data(), buffer.size())) {
+            auto err = errnoError("Failed to append to Image Store " + file_path);
+            // drop the partial Record so the next append starts on a Record boundary
+            (void) ::ftruncate(fd, static_cast<off_t>(end_offset));
+            return err;
+        }
+
+        index[record.hash] = end_offset;
+        end_offset += buffer.size();
+
+        return llvm::Error::success();
+    }
+
+    auto ImageStore::size() const -> size_t {
+        std::shared_lock<folly::SharedMutex> readerLock(mutex);
+        return index.size();
+    }
+
+} // namespace imgstr
@@ -0,0 +1,103 @@
+#include "traineddata.h"
+#include <cstdlib>
+#include <fcntl.h>
+#include <llvm/ADT/SmallString.h>
+#include <llvm/ADT/SmallVector.h>
+#include <llvm/Support/FileSystem.h>
+#include <llvm/Support/FormatVariadic.h>
+#include <llvm/Support/Path.h>
+#include <mutex>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <unordered_map>
+
+namespace {
+    /// @brief Live Mappings by Language - weak so a Model is unmapped once no Pool uses it
+    struct Registry {
+        std::mutex                                                        mutex;
+        std::unordered_map<std::string, std::weak_ptr<const TrainedData>> models;
+    };
+
+    auto registry() -> Registry & {
+        static Registry instance;
+        return instance;
+    }
+
+    auto findTrainedData(const std::string &lang) -> std::string {
+        llvm::SmallVector<std::string, 3> roots;
+
+        if (const char *prefix = std::getenv("TESSDATA_PREFIX")) {
+            roots.emplace_back(prefix);
+            roots.push_back(std::string(prefix) + "/tessdata");
+        }
+#ifdef TESSDATA_PREFIX
+        roots.emplace_back(TESSDATA_PREFIX);
+#endif
+
+        for (const auto &root: roots) {
+            llvm::SmallString<256> candidate(root);
+            llvm::sys::path::append(candidate, lang + ".traineddata");
+            if (llvm::sys::fs::exists(candidate)) {
+                return candidate.str().str();
+            }
+        }
+        return {};
+    }
+} // namespace
+
+TrainedData::TrainedData(std::string path, const char *mapped, std::size_t length)
+    : file_path(std::move(path)),
+      mapped(mapped),
+      length(length) {}
+
+TrainedData::~TrainedData() {
+    if (mapped != nullptr) {
+        ::munmap(const_cast<char *>(mapped), length);
+    }
+}
+
+auto TrainedData::map(const std::string &lang)
+    -> llvm::Expected<std::shared_ptr<const TrainedData>> {
+    auto                       &live_models = registry();
+    std::lock_guard<std::mutex> lock(live_models.mutex);
+
+    if (auto live = live_models.models[lang].lock()) {
+        return live;
+    }
+
+    std::string path = findTrainedData(lang);
+    if (path.empty()) {
+        return llvm::make_error<llvm::StringError>(
+            llvm::formatv("{0}.traineddata not found - set TESSDATA_PREFIX", lang).str(),
+            std::make_error_code(std::errc::no_such_file_or_directory));
+    }
+
+    int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return llvm::errorCodeToError(std::error_code(errno, std::generic_category()));
+    }
+
+    struct stat st {};
+    if (::fstat(fd, &st) != 0 || st.st_size == 0) {
+        ::close(fd);
+        return llvm::make_error<llvm::StringError>(
+            llvm::formatv("Failed to stat traineddata {0}", path).str(),
+            std::make_error_code(std::errc::io_error));
+    }
+
+    auto  length = static_cast<std::size_t>(st.st_size);
+    void *region = ::mmap(nullptr, length, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+
+    if (region == MAP_FAILED) {
+        return llvm::errorCodeToError(std::error_code(errno, std::generic_category()));
+    }
+
+    std::shared_ptr<const TrainedData> model(
+        new TrainedData(std::move(path), static_cast<const char *>(region), length));
+
+    live_models.models[lang] = model;
+
+    return model;
+}
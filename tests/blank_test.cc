@@ -0,0 +1,66 @@
+#include <blank.h>
+#include <gtest/gtest.h>
+
+namespace blank_test_constants {
+    /// @brief 8 bpp white Page, optionally with black Text-like Bars every few Rows
+    auto page(l_int32 width, l_int32 height, bool with_text) -> PixPtr {
+        PixPtr pix(pixCreate(width, height, 8));
+        for (l_int32 y = 0; y < height; ++y) {
+            for (l_int32 x = 0; x < width; ++x) {
+                bool ink = with_text && (y % 20) < 6 && (x % 12) < 7;
+                pixSetPixel(pix.get(), x, y, ink ? 0 : 255);
+            }
+        }
+        return pix;
+    }
+
+    /// @brief A4 at 300 DPI, white but for one short Line of Strokes at the Foot - a Page Number
+    auto pageNumberOnly() -> PixPtr {
+        PixPtr pix(pixCreate(2480, 3508, 8));
+        pixSetAllArbitrary(pix.get(), 255);
+        for (l_int32 y = 3300; y < 3330; ++y) {
+            for (l_int32 x = 1220; x < 1260; ++x) {
+                if ((x % 12) < 3) {
+                    pixSetPixel(pix.get(), x, y, 0);
+                }
+            }
+        }
+        return pix;
+    }
+} // namespace blank_test_constants
+
+using namespace blank_test_constants;
+
+TEST(BlankDetectionTest, WhitePageIsBlank) {
+    auto white = page(200, 300, false);
+
+    auto stats = imgstr::measureInk(white.get());
+    ASSERT_TRUE(stats.has_value());
+    EXPECT_EQ(stats->ink_fraction, 0.0F);
+    EXPECT_EQ(stats->edge_density, 0.0F);
+    EXPECT_TRUE(imgstr::isBlankImage(white.get()));
+}
+
+TEST(BlankDetectionTest, PageWithStrokesIsNotBlank) {
+    auto text = page(200, 300, true);
+
+    auto stats = imgstr::measureInk(text.get());
+    ASSERT_TRUE(stats.has_value());
+    EXPECT_GT(stats->ink_fraction, 0.1F);
+    EXPECT_GT(stats->edge_density, 0.1F);
+    EXPECT_FALSE(imgstr::isBlankImage(text.get()));
+}
+
+TEST(BlankDetectionTest, SingleShortTextLineIsNotBlank) {
+    auto sparse = pageNumberOnly();
+
+    auto stats = imgstr::measureInk(sparse.get());
+    ASSERT_TRUE(stats.has_value());
+    EXPECT_GT(stats->ink_fraction, imgstr::BlankOptions {}.min_ink_fraction);
+    EXPECT_FALSE(imgstr::isBlankImage(sparse.get()));
+}
+
+auto main(int argc, char **argv) -> int {
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,202 @@
+#include <cache.h>
+#include <atomic>
+#include <chrono>
+#include <gtest/gtest.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+using imgstr::ClockCache;
+using imgstr::SingleFlight;
+
+TEST(ClockCacheTest, InsertThenFind) {
+    ClockCache<std::string, std::string> cache(10, 1024);
+
+    cache.insert("a", "alpha", 5);
+
+    auto hit = cache.find("a");
+    ASSERT_NE(hit, nullptr);
+    EXPECT_EQ(*hit, "alpha");
+    EXPECT_EQ(cache.find("b"), nullptr);
+    EXPECT_EQ(cache.size(), 1);
+    EXPECT_EQ(cache.bytes(), 5);
+}
+
+TEST(ClockCacheTest, DuplicateInsertReturnsExisting) {
+    ClockCache<std::string, std::string> cache(10, 1024);
+
+    cache.insert("a", "first", 5);
+    auto second = cache.insert("a", "second", 6);
+
+    EXPECT_EQ(*second, "first");
+    EXPECT_EQ(cache.size(), 1);
+    EXPECT_EQ(cache.bytes(), 5);
+}
+
+TEST(ClockCacheTest, ReplaceSwapsValueAndAccounting) {
+    ClockCache<std::string, std::string> cache(10, 1024);
+
+    auto first    = cache.insert("a", "first", 5);
+    auto replaced = cache.replace("a", "replaced", 8);
+
+    EXPECT_EQ(*first, "first");
+    EXPECT_EQ(*replaced, "replaced");
+    EXPECT_EQ(*cache.find("a"), "replaced");
+    EXPECT_EQ(cache.size(), 1);
+    EXPECT_EQ(cache.bytes(), 8);
+
+    cache.replace("b", "new", 3);
+    EXPECT_EQ(*cache.find("b"), "new");
+    EXPECT_EQ(cache.size(), 2);
+}
+
+TEST(ClockCacheTest, EvictsToStayWithinByteBudget) {
+    ClockCache<int, std::string> cache(100, 30);
+
+    for (int i = 0; i < 10; ++i) {
+        cache.insert(i, std::string(10, 'x'), 10);
+        EXPECT_LE(cache.bytes(), 30);
+    }
+
+    EXPECT_EQ(cache.size(), 3);
+    EXPECT_NE(cache.find(9), nullptr);
+}
+
+TEST(ClockCacheTest, EvictsToStayWithinEntryCapacity) {
+    ClockCache<int, int> cache(4, 1 << 20);
+
+    for (int i = 0; i < 100; ++i) {
+        cache.insert(i, int(i), 1);
+    }
+
+    EXPECT_EQ(cache.size(), 4);
+}
+
+TEST(ClockCacheTest, CountsInsertsAndEvictions) {
+    ClockCache<int, int> cache(4, 1 << 20);
+
+    for (int i = 0; i < 10; ++i) {
+        cache.insert(i, int(i), 1);
+    }
+    cache.insert(9, 9, 1);
+
+    EXPECT_EQ(cache.insertCount(), 10);
+    EXPECT_EQ(cache.evictionCount(), 6);
+}
+
+TEST(ClockCacheTest, ReferencedEntriesGetSecondChance) {
+    ClockCache<int, int> cache(3, 1 << 20);
+
+    cache.insert(1, 1, 1);
+    cache.insert(2, 2, 1);
+    cache.insert(3, 3, 1);
+
+    cache.insert(4, 4, 1); // full sweep clears all bits and evicts 1
+
+    cache.find(2);
+    cache.insert(5, 5, 1); // 2 was referenced again, 3 is the victim
+
+    EXPECT_NE(cache.find(2), nullptr);
+    EXPECT_EQ(cache.find(3), nullptr);
+}
+
+TEST(ClockCacheTest, OversizedValueIsNotCached) {
+    ClockCache<int, std::string> cache(10, 8);
+
+    auto value = cache.insert(1, std::string(16, 'x'), 16);
+
+    ASSERT_NE(value, nullptr);
+    EXPECT_EQ(cache.find(1), nullptr);
+    EXPECT_EQ(cache.bytes(), 0);
+}
+
+TEST(ClockCacheTest, EvictedValueOutlivesEviction) {
+    ClockCache<int, std::string> cache(1, 1024);
+
+    auto held = cache.insert(1, "kept alive", 10);
+    cache.insert(2, "evicts one", 10);
+
+    EXPECT_EQ(cache.find(1), nullptr);
+    EXPECT_EQ(*held, "kept alive");
+}
+
+TEST(ClockCacheTest, EvictionListenerSeesEvictedEntries) {
+    ClockCache<int, int> cache(2, 1 << 20);
+    std::vector<int>     evicted;
+
+    cache.onEvict([&evicted](const int &key, const int &value) {
+        EXPECT_EQ(value, key * 10);
+        evicted.push_back(key);
+    });
+
+    for (int i = 0; i < 5; ++i) {
+        cache.insert(i, i * 10, 1);
+    }
+
+    EXPECT_EQ(evicted.size(), 3);
+    EXPECT_EQ(evicted.size(), cache.evictionCount());
+    for (int key: evicted) {
+        EXPECT_EQ(cache.find(key), nullptr);
+    }
+}
+
+TEST(ClockCacheTest, ConcurrentInsertAndFind) {
+    ClockCache<int, int> cache(64, 1 << 20);
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&cache, t] {
+            for (int i = 0; i < 1000; ++i) {
+                cache.insert(t * 1000 + i, int(i), 8);
+                cache.find(t * 1000 + i / 2);
+            }
+        });
+    }
+    for (auto &thread: threads) {
+        thread.join();
+    }
+
+    EXPECT_LE(cache.size(), 64);
+    EXPECT_EQ(cache.bytes(), cache.size() * 8);
+}
+
+TEST(SingleFlightTest, ConcurrentCallersShareOneCall) {
+    SingleFlight<int, int> flight;
+    std::atomic<int>       calls {0};
+    std::atomic<int>       shared {0};
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 8; ++t) {
+        threads.emplace_back([&] {
+            auto [value, waited] = flight.run(7, [&] {
+                calls.fetch_add(1);
+                std::this_thread::sleep_for(std::chrono::milliseconds(100));
+                return 42;
+            });
+            EXPECT_EQ(value, 42);
+            shared.fetch_add(waited ? 1 : 0);
+        });
+    }
+    for (auto &thread: threads) {
+        thread.join();
+    }
+
+    EXPECT_EQ(calls.load() + shared.load(), 8);
+    EXPECT_LT(calls.load(), 8);
+    EXPECT_EQ(flight.size(), 0);
+}
+
+TEST(SingleFlightTest, LeaderExceptionIsPropagated) {
+    SingleFlight<int, int> flight;
+
+    EXPECT_THROW(flight.run(1, []() -> int { throw std::runtime_error("ocr failed"); }),
+                 std::runtime_error);
+    EXPECT_EQ(flight.size(), 0);
+
+    EXPECT_EQ(flight.run(1, [] { return 5; }).first, 5);
+}
+
+auto main(int argc, char **argv) -> int {
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,28 @@
+#include <compress.h>
+#include <gtest/gtest.h>
+#include <string>
+
+TEST(CompressTextTest, RoundTrip) {
+    std::string text;
+    for (int i = 0; i < 200; ++i) {
+        text += "The quick brown fox jumps over the lazy dog.\n";
+    }
+
+    auto packed = compressText(text);
+
+    EXPECT_LT(packed.size(), text.size() / 4);
+    EXPECT_EQ(decompressText(packed, text.size()), text);
+}
+
+TEST(CompressTextTest, WrongSizeThrows) {
+    std::string text(1000, 'a');
+    auto        packed = compressText(text);
+
+    EXPECT_THROW(decompressText(packed, text.size() - 1), std::runtime_error);
+    EXPECT_THROW(decompressText("not zlib", 10), std::runtime_error);
+}
+
+auto main(int argc, char **argv) -> int {
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
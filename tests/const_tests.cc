@@ -1,3 +1,4 @@
+#include <crypto.h>
 #include <fs.h>
 #include <gtest/gtest.h>
 #include <util.h>
@@ -34,6 +35,31 @@ TEST_F(ConstTests, BasicTest) {
     }
 }
 
+TEST_F(ConstTests, LanguageKeys) {
+    EXPECT_STREQ(isoToTesseractLang(ISOLang::en), "eng");
+    EXPECT_STREQ(isoToTesseractLang(ISOLang::de), "deu");
+    EXPECT_STREQ(isoToTesseractLang(ISOLang::es), "spa");
+
+    Sha256Digest digest = computeSHA256(std::vector<unsigned char> {'i', 'm', 'g'});
+
+    EXPECT_EQ(languageKey(digest, "eng"), digest);
+    EXPECT_NE(languageKey(digest, "deu"), digest);
+    EXPECT_NE(languageKey(digest, "deu"), languageKey(digest, "spa"));
+    EXPECT_EQ(languageKey(digest, "deu"), languageKey(digest, "deu"));
+}
+
+TEST_F(ConstTests, ProfileKeys) {
+    EXPECT_EQ(engineKey("eng", OcrProfile::balanced), "eng");
+    EXPECT_EQ(engineKey("deu", OcrProfile::fast), "deu:fast");
+    EXPECT_EQ(engineKey("eng", OcrProfile::accurate), "eng:accurate");
+
+    Sha256Digest digest = computeSHA256(std::vector<unsigned char> {'i', 'm', 'g'});
+
+    EXPECT_EQ(languageKey(digest, engineKey("eng", OcrProfile::balanced)), digest);
+    EXPECT_NE(languageKey(digest, engineKey("eng", OcrProfile::fast)),
+              languageKey(digest, engineKey("eng", OcrProfile::accurate)));
+}
+
 auto main(int argc, char **argv) -> int {
     testing::InitGoogleTest(&argc, argv);
     return RUN_ALL_TESTS();
@@ -0,0 +1,147 @@
+#include <gtest/gtest.h>
+#include <imghash.h>
+
+using imgstr::FuzzHash;
+using imgstr::NearDuplicateIndex;
+
+namespace {
+    auto hashWithBits(std::initializer_list<int> set_bits, float aspect = 1.5F) -> FuzzHash {
+        FuzzHash hash;
+        hash.aspect = aspect;
+        for (int bit: set_bits) {
+            hash.bits[bit / 64] |= uint64_t {1} << (bit % 64);
+        }
+        return hash;
+    }
+
+    auto digestOf(uint8_t fill) -> Sha256Digest {
+        Sha256Digest digest;
+        digest.bytes.fill(fill);
+        return digest;
+    }
+
+    /// Letter sized 1bpp Page at 150 dpi - the same Margins and Font for every Text, so only the
+    /// Words differ
+    auto renderTextPage(const char *text) -> PixPtr {
+        PixPtr page(pixCreate(1275, 1650, 1));
+        L_BMF *font = bmfCreate(nullptr, 14);
+
+        std::string body;
+        for (int i = 0; i < 12; ++i) {
+            body += text;
+            body += ' ';
+        }
+
+        l_int32 overflow = 0;
+        pixSetTextblock(page.get(), font, body.c_str(), 1, 100, 100, 1075, 0, &overflow);
+        bmfDestroy(&font);
+        return page;
+    }
+
+    constexpr const char *TWO_CITIES =
+        "It was the best of times, it was the worst of times, it was the age of wisdom, it was "
+        "the age of foolishness, it was the epoch of belief, it was the epoch of incredulity, it "
+        "was the season of Light, it was the season of Darkness, it was the spring of hope, it "
+        "was the winter of despair, we had everything before us, we had nothing before us.";
+
+    constexpr const char *DECLARATION =
+        "When in the Course of human events, it becomes necessary for one people to dissolve the "
+        "political bands which have connected them with another, and to assume among the powers "
+        "of the earth, the separate and equal station to which the Laws of Nature and of Nature's "
+        "God entitle them, a decent respect to the opinions of mankind requires that they should.";
+} // namespace
+
+TEST(FuzzHashTest, StringRoundTrip) {
+    auto hash    = hashWithBits({0, 63, 64, 200, 255}, 0.75F);
+    auto decoded = FuzzHash::fromString(hash.toString());
+
+    ASSERT_TRUE(decoded.has_value());
+    EXPECT_EQ(decoded->bits, hash.bits);
+    EXPECT_FLOAT_EQ(decoded->aspect, 0.75F);
+    EXPECT_FALSE(FuzzHash::fromString("not a hash").has_value());
+}
+
+TEST(FuzzHashTest, HammingDistance) {
+    EXPECT_EQ(hashWithBits({1, 2, 3}).distance(hashWithBits({1, 2, 3})), 0);
+    EXPECT_EQ(hashWithBits({1, 2, 3}).distance(hashWithBits({1, 100, 250})), 4);
+}
+
+TEST(NearDuplicateIndexTest, FindsClosestWithinRadius) {
+    NearDuplicateIndex index(4);
+
+    index.insert(hashWithBits({}), digestOf(1));
+    index.insert(hashWithBits({10, 11, 12}), digestOf(2));
+    index.insert(hashWithBits({10, 11, 12, 13, 14, 15, 16, 17, 18, 19}), digestOf(3));
+
+    auto match = index.findNearest(hashWithBits({10, 11}));
+    ASSERT_TRUE(match.has_value());
+    EXPECT_EQ(*match, digestOf(2));
+
+    EXPECT_FALSE(index.findNearest(hashWithBits({100, 101, 102, 103, 104, 105})).has_value());
+}
+
+TEST(NearDuplicateIndexTest, RejectsDifferentAspectRatio) {
+    NearDuplicateIndex index(4);
+
+    index.insert(hashWithBits({1}, 1.0F), digestOf(1));
+
+    EXPECT_TRUE(index.findNearest(hashWithBits({1}, 1.01F)).has_value());
+    EXPECT_FALSE(index.findNearest(hashWithBits({1}, 1.5F)).has_value());
+}
+
+TEST(NearDuplicateIndexTest, MatchesOnlyWithinTag) {
+    NearDuplicateIndex index(4);
+
+    index.insert(hashWithBits({1, 2}), digestOf(1), 7);
+    index.insert(hashWithBits({1, 2, 3}), digestOf(2), 9);
+
+    auto match = index.findNearest(hashWithBits({1, 2}), 9);
+    ASSERT_TRUE(match.has_value());
+    EXPECT_EQ(*match, digestOf(2));
+
+    index.erase(digestOf(1));
+    EXPECT_FALSE(index.findNearest(hashWithBits({1, 2}), 7).has_value());
+    EXPECT_TRUE(index.findNearest(hashWithBits({1, 2}), 9).has_value());
+}
+
+TEST(NearDuplicateIndexTest, EraseForgetsEntry) {
+    NearDuplicateIndex index(4);
+
+    for (int i = 0; i < 8; ++i) {
+        index.insert(hashWithBits({i * 20, i * 20 + 1, i * 20 + 2}), digestOf(i));
+    }
+    ASSERT_EQ(index.size(), 8U);
+
+    for (int i = 0; i < 6; ++i) {
+        index.erase(digestOf(i));
+    }
+
+    EXPECT_EQ(index.size(), 2U);
+    EXPECT_FALSE(index.findNearest(hashWithBits({0, 1, 2})).has_value());
+
+    auto match = index.findNearest(hashWithBits({140, 141}));
+    ASSERT_TRUE(match.has_value());
+    EXPECT_EQ(*match, digestOf(7));
+}
+
+TEST(NearDuplicateIndexTest, DifferentTextPagesDoNotMatch) {
+    auto first  = renderTextPage(TWO_CITIES);
+    auto second = renderTextPage(DECLARATION);
+
+    auto first_hash  = imgstr::computeFuzzHash(first.get());
+    auto second_hash = imgstr::computeFuzzHash(second.get());
+    ASSERT_TRUE(first_hash && second_hash);
+
+    EXPECT_GT(first_hash->distance(*second_hash), 8U);
+
+    NearDuplicateIndex index(8);
+    index.insert(*first_hash, digestOf(1));
+
+    EXPECT_FALSE(index.findNearest(*second_hash).has_value());
+    EXPECT_TRUE(index.findNearest(*first_hash).has_value());
+}
+
+auto main(int argc, char **argv) -> int {
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
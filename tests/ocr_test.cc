@@ -14,6 +14,7 @@
 #include <ranges>
 #include <tesseract/baseapi.h>
 #include <textract.h>
+#include <thread>
 
 #ifdef _USE_OPENCV
 #include <opencv2/core/check.hpp>
@@ -185,6 +186,140 @@ TEST_F(ImageProcessingTests, BasicAssertions) {
     EXPECT_EQ(7 * 6, 42);
 }
 
+TEST_F(ImageProcessingTests, EnginePoolBoundsEnginesAcrossThreads) {
+    TesseractPool pool(2);
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 6; ++t) {
+        threads.emplace_back([&pool, this] {
+            PixPtr pix = decodePix(readBytesFromFile(fpaths[0]));
+            EXPECT_FALSE(getTextOCR(pool, pix.get()).empty());
+        });
+    }
+    for (auto &thread: threads) {
+        thread.join();
+    }
+
+    EXPECT_LE(pool.size(), 2);
+}
+
+TEST_F(ImageProcessingTests, EnginePoolWarmsUpToCapacity) {
+    TesseractPool pool(2);
+
+    auto init_ms = pool.warm(4);
+
+    EXPECT_EQ(init_ms.size(), 2);
+    EXPECT_EQ(pool.size(), 2);
+    EXPECT_TRUE(pool.warm(2).empty());
+}
+
+TEST_F(ImageProcessingTests, TrainedDataMappingIsReusedAcrossPools) {
+    auto first  = TrainedData::map("eng");
+    auto second = TrainedData::map("eng");
+    ASSERT_TRUE(static_cast<bool>(first)) << llvm::toString(first.takeError());
+    ASSERT_TRUE(static_cast<bool>(second)) << llvm::toString(second.takeError());
+
+    EXPECT_EQ(first->get(), second->get());
+    EXPECT_GT((*first)->size(), 0);
+
+    TesseractPool pool(2);
+    pool.warm(2);
+    EXPECT_EQ(pool.modelPath(), (*first)->path());
+}
+
+TEST_F(ImageProcessingTests, LayoutFilterRecognizesOnlyTextRegions) {
+    TesseractPool pool(1);
+
+    PixPtr document = decodePix(readBytesFromFile(fpaths[0]));
+    EXPECT_FALSE(imgstr::getTextOCRTextRegions(pool, document.get()).empty());
+
+    PixPtr blank(pixCreate(640, 480, 8));
+    pixSetAll(blank.get());
+    EXPECT_TRUE(imgstr::getTextOCRTextRegions(pool, blank.get()).empty());
+}
+
+TEST_F(ImageProcessingTests, AdaptiveOCRFallsBackBelowConfidence) {
+    TesseractPool fast(1, "eng", OcrProfile::fast);
+    TesseractPool accurate(1, "eng", OcrProfile::accurate);
+
+    PixPtr pix = decodePix(readBytesFromFile(fpaths[0]));
+
+    auto trusted = imgstr::getTextOCRAdaptive(fast, accurate, pix.get(), ImgMode::document,
+                                              {.min_mean_conf = 0, .max_low_words = 1.0F});
+    EXPECT_FALSE(trusted.second_pass);
+    EXPECT_FALSE(trusted.text.empty());
+
+    auto doubted = imgstr::getTextOCRAdaptive(fast, accurate, pix.get(), ImgMode::document,
+                                              {.min_mean_conf = 101});
+    EXPECT_TRUE(doubted.second_pass);
+    EXPECT_FALSE(doubted.text.empty());
+}
+
+TEST_F(ImageProcessingTests, DeadlineCancelsRecognition) {
+    TesseractPool pool(1);
+
+    PixPtr pix = decodePix(readBytesFromFile(fpaths[0]));
+
+    auto passed = std::chrono::steady_clock::now() - std::chrono::seconds(1);
+    EXPECT_THROW(getTextOCR(pool, pix.get(), ImgMode::document, passed), OcrTimeoutError);
+
+    auto generous = std::chrono::steady_clock::now() + std::chrono::minutes(5);
+    EXPECT_FALSE(getTextOCR(pool, pix.get(), ImgMode::document, generous).empty());
+}
+
+TEST_F(ImageProcessingTests, WordResultsMatchText) {
+    TesseractPool pool(1);
+
+    PixPtr pix = decodePix(readBytesFromFile(fpaths[0]));
+
+    auto result = imgstr::getTextOCRWords(pool, pix.get());
+    ASSERT_FALSE(result.words.empty());
+    EXPECT_EQ(result.words.boxes.size(), result.words.size());
+
+    for (std::size_t i = 0; i < result.words.size(); ++i) {
+        EXPECT_NE(result.text.find(result.words.word(i)), std::string::npos);
+        EXPECT_LT(result.words.boxes[i].left, result.words.boxes[i].right);
+        EXPECT_LE(result.words.boxes[i].right, pixGetWidth(pix.get()));
+    }
+}
+
+TEST_F(ImageProcessingTests, ConvertSingleImageToHocrFile) {
+    imgstr::ImgProcessor imageTranslator;
+    imageTranslator.convertImageToTextFile(
+        fpaths[0], tempDir, true, ISOLang::en, imgstr::OutputFormat::hocr);
+
+    std::filesystem::path hocr = tempDir / std::filesystem::path(fpaths[0]).filename();
+    hocr.replace_extension(".hocr");
+    ASSERT_TRUE(std::filesystem::exists(hocr));
+
+    std::string content = readFileToString(hocr.string());
+    EXPECT_NE(content.find("ocrx_word"), std::string::npos);
+    EXPECT_NE(content.find("</html>"), std::string::npos);
+}
+
+TEST_F(ImageProcessingTests, MultipageTiffIsReadPageByPage) {
+    imgstr::ImgProcessor imageTranslator;
+
+    std::string inputDir  = tempDir + "/multipage";
+    std::string outputDir = tempDir + "/out";
+    std::string tiff      = inputDir + "/document.tif";
+    ASSERT_TRUE(std::filesystem::create_directories(inputDir));
+
+    PixPtr page = decodePix(readBytesFromFile(fpaths[0]));
+    for (int i = 0; i < 2; ++i) {
+        ASSERT_EQ(pixWriteTiff(tiff.c_str(), page.get(), IFF_TIFF_ZIP, i == 0 ? "w" : "a"), 0);
+    }
+
+    auto text = imageTranslator.getTextFromImage(tiff);
+    auto feed = text.find('\f');
+    ASSERT_NE(feed, std::string::npos);
+    EXPECT_EQ(text.substr(0, feed), text.substr(feed + 1));
+    EXPECT_FALSE(text.substr(0, feed).empty());
+
+    imageTranslator.simpleProcessDir(inputDir, outputDir);
+    EXPECT_EQ(readFileToString(outputDir + "/document.txt"), text);
+}
+
 TEST_F(ImageProcessingTests, OEMvsLSTMAnalysis) {
     auto start = getStartTime();
     auto res1  = extractTextFromImageFileLeptonica(fpaths[1]);
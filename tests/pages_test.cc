@@ -0,0 +1,72 @@
+#include <cstdio>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <iterator>
+#include <pix.h>
+
+namespace pages_test_constants {
+    static constexpr auto multipageFile = "pages_test.tif";
+
+    /// @brief 1 bpp Page with a Bar whose Position tells the Pages apart
+    auto page(l_int32 width, l_int32 height, l_int32 bar) -> PixPtr {
+        PixPtr pix(pixCreate(width, height, 1));
+        for (l_int32 y = bar; y < bar + 4; ++y) {
+            for (l_int32 x = 8; x < width - 8; ++x) {
+                pixSetPixel(pix.get(), x, y, 1);
+            }
+        }
+        return pix;
+    }
+
+    auto readBytes(const char *path) -> std::vector<unsigned char> {
+        std::ifstream file(path, std::ios::binary);
+        return {std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+    }
+} // namespace pages_test_constants
+
+using namespace pages_test_constants;
+
+TEST(MultipageTest, EveryTiffPageIsDecodedInOrder) {
+    std::vector<l_int32> heights = {100, 140, 180};
+    for (std::size_t i = 0; i < heights.size(); ++i) {
+        auto pix = page(120, heights[i], 10 * static_cast<l_int32>(i + 1));
+        ASSERT_EQ(pixWriteTiff(multipageFile, pix.get(), IFF_TIFF_G4, i == 0 ? "w" : "a"), 0);
+    }
+
+    auto pages = decodePages(readBytes(multipageFile));
+    auto count = countPages(multipageFile);
+    std::remove(multipageFile);
+
+    EXPECT_EQ(count, heights.size());
+
+    ASSERT_EQ(pages.size(), heights.size());
+    for (std::size_t i = 0; i < heights.size(); ++i) {
+        EXPECT_EQ(pixGetWidth(pages[i].get()), 120);
+        EXPECT_EQ(pixGetHeight(pages[i].get()), heights[i]);
+    }
+}
+
+TEST(MultipageTest, SinglePageFormatsYieldOnePage) {
+    auto pix = page(64, 48, 20);
+
+    l_uint8 *data = nullptr;
+    size_t   size = 0;
+    ASSERT_EQ(pixWriteMem(&data, &size, pix.get(), IFF_PNG), 0);
+    std::vector<unsigned char> png(data, data + size);
+    lept_free(data);
+
+    auto pages = decodePages(png);
+
+    ASSERT_EQ(pages.size(), 1);
+    EXPECT_EQ(pixGetHeight(pages[0].get()), 48);
+}
+
+TEST(MultipageTest, UndecodableBytesThrow) {
+    std::vector<unsigned char> garbage = {'n', 'o', 't'};
+    EXPECT_THROW(decodePages(garbage), std::runtime_error);
+}
+
+auto main(int argc, char **argv) -> int {
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,50 @@
+#include <gtest/gtest.h>
+#include <pathindex.h>
+
+using imgstr::FileIdentity;
+using imgstr::PathIndex;
+
+namespace {
+    auto digestOf(uint8_t fill) -> Sha256Digest {
+        Sha256Digest digest;
+        digest.bytes.fill(fill);
+        return digest;
+    }
+
+    auto identityOf(uint64_t inode, int64_t mtime = 1) -> FileIdentity {
+        return FileIdentity {1, inode, 100, mtime};
+    }
+} // namespace
+
+TEST(PathIndexTest, EraseDropsEveryIdentityOfDigest) {
+    PathIndex index;
+
+    index.insert(identityOf(1), digestOf(1));
+    index.insert(identityOf(2), digestOf(1)); // a Copy of the same Bytes
+    index.insert(identityOf(3), digestOf(2));
+
+    index.erase(digestOf(1));
+
+    EXPECT_FALSE(index.find(identityOf(1)).has_value());
+    EXPECT_FALSE(index.find(identityOf(2)).has_value());
+    EXPECT_EQ(index.find(identityOf(3)), digestOf(2));
+    EXPECT_EQ(index.size(), 1);
+}
+
+TEST(PathIndexTest, RemappedIdentityIsNotErasedWithOldDigest) {
+    PathIndex index;
+
+    index.insert(identityOf(1), digestOf(1));
+    index.insert(identityOf(1), digestOf(2));
+
+    index.erase(digestOf(1));
+    EXPECT_EQ(index.find(identityOf(1)), digestOf(2));
+
+    index.erase(digestOf(2));
+    EXPECT_EQ(index.size(), 0);
+}
+
+auto main(int argc, char **argv) -> int {
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
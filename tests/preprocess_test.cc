@@ -0,0 +1,82 @@
+#include <gtest/gtest.h>
+#include <preprocess.h>
+
+using namespace imgstr;
+
+TEST(PreprocessPipelineTest, RunsStepsInOrderAndTimesEach) {
+    PreprocessPipeline pipeline;
+    pipeline.add("widen", [](Pix *pix) { return PixPtr(pixCreate(pixGetWidth(pix) * 2, 10, 8)); })
+        .add("noop", [](Pix *) { return PixPtr(); })
+        .add("narrow", [](Pix *pix) { return PixPtr(pixCreate(pixGetWidth(pix) - 5, 10, 8)); });
+
+    PixPtr input(pixCreate(20, 10, 8));
+
+    for (int i = 0; i < 3; ++i) {
+        PixPtr output = pipeline.run(input.get());
+        ASSERT_NE(output, nullptr);
+        EXPECT_EQ(pixGetWidth(output.get()), 35);
+    }
+
+    auto timings = pipeline.timings();
+    ASSERT_EQ(timings.size(), 3);
+    EXPECT_EQ(timings[0].name, "widen");
+    EXPECT_EQ(timings[1].name, "noop");
+    EXPECT_EQ(timings[2].name, "narrow");
+
+    for (const auto &step: timings) {
+        EXPECT_EQ(step.runs, 3);
+        EXPECT_GE(step.total_ms, 0.0);
+    }
+    EXPECT_EQ(timings[0].skipped, 0);
+    EXPECT_EQ(timings[1].skipped, 3);
+}
+
+TEST(PreprocessPipelineTest, EmptyPipelineLeavesImageUnchanged) {
+    PreprocessPipeline pipeline;
+    PixPtr             input(pixCreate(20, 10, 8));
+
+    EXPECT_TRUE(pipeline.empty());
+    EXPECT_EQ(pipeline.run(input.get()), nullptr);
+}
+
+TEST(PreprocessPipelineTest, BinarizeProducesOneBitImage) {
+    PreprocessPipeline pipeline;
+    pipeline.grayscale().binarize();
+
+    PixPtr input(pixCreate(64, 64, 32));
+    PixPtr output = pipeline.run(input.get());
+
+    ASSERT_NE(output, nullptr);
+    EXPECT_EQ(pixGetDepth(output.get()), 1);
+}
+
+TEST(PreprocessPipelineTest, DeskewOfLevelPageIsSkipped) {
+    PreprocessPipeline pipeline;
+    pipeline.deskew();
+
+    PixPtr input(pixCreate(200, 100, 8));
+    pixSetAllArbitrary(input.get(), 255);
+
+    EXPECT_EQ(pipeline.run(input.get()), nullptr);
+    EXPECT_EQ(pipeline.timings()[0].skipped, 1);
+}
+
+TEST(PreprocessPipelineTest, KeepGeometryLeavesOutStepsThatMovePixels) {
+    PreprocessPipeline pipeline;
+    pipeline.add("rotate", [](Pix *pix) { return PixPtr(pixCreate(pixGetHeight(pix), 20, 8)); },
+                 true);
+
+    PixPtr input(pixCreate(20, 10, 8));
+
+    EXPECT_EQ(pipeline.run(input.get(), true), nullptr);
+    EXPECT_EQ(pipeline.timings()[0].runs, 0);
+
+    PixPtr output = pipeline.run(input.get());
+    ASSERT_NE(output, nullptr);
+    EXPECT_EQ(pixGetWidth(output.get()), 10);
+}
+
+auto main(int argc, char **argv) -> int {
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
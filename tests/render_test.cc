@@ -0,0 +1,97 @@
+#include <filesystem>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <llvm/Support/raw_ostream.h>
+#include <render.h>
+
+namespace render_test_constants {
+    /// @brief Two Blocks - a Line of two Words and a Line with Markup to escape
+    auto sampleWords() -> imgstr::OcrWords {
+        imgstr::OcrWords words;
+        words.page_width  = 400;
+        words.page_height = 200;
+        words.push("Hello", {10, 20, 60, 40}, 95.5F, 0, 0);
+        words.push("World", {70, 22, 130, 42}, 88.0F, 0, 0);
+        words.push("a<b&c", {10, 120, 90, 140}, 61.0F, 1, 1);
+        return words;
+    }
+
+    template <typename Writer>
+    auto render(Writer &&writer) -> std::string {
+        std::string              out;
+        llvm::raw_string_ostream os(out);
+        writer(os);
+        os.flush();
+        return out;
+    }
+} // namespace render_test_constants
+
+using namespace render_test_constants;
+
+TEST(RenderTest, TsvHasARowPerLevel) {
+    auto words = sampleWords();
+    auto tsv   = render([&](llvm::raw_ostream &os) { imgstr::writeTSV(os, words); });
+
+    EXPECT_EQ(tsv.rfind("level\tpage_num", 0), 0);
+    EXPECT_NE(tsv.find("1\t1\t0\t0\t0\t0\t0\t0\t400\t200\t-1\t\n"), std::string::npos);
+    EXPECT_NE(tsv.find("4\t1\t1\t1\t1\t0\t10\t20\t120\t22\t-1\t\n"), std::string::npos);
+    EXPECT_NE(tsv.find("5\t1\t1\t1\t1\t2\t70\t22\t60\t20\t88.000000\tWorld\n"),
+              std::string::npos);
+    EXPECT_NE(tsv.find("5\t1\t2\t1\t1\t1\t10\t120\t80\t20\t61.000000\ta<b&c\n"),
+              std::string::npos);
+}
+
+TEST(RenderTest, HocrNestsLinesInBlocksAndEscapes) {
+    auto words = sampleWords();
+    auto hocr  = render([&](llvm::raw_ostream &os) { imgstr::writeHOCR(os, words, "scan.png"); });
+
+    EXPECT_NE(hocr.find("bbox 0 0 400 200"), std::string::npos);
+    EXPECT_NE(hocr.find("id=\"block_1_2\""), std::string::npos);
+    EXPECT_NE(hocr.find("title=\"bbox 10 20 130 42\""), std::string::npos);
+    EXPECT_NE(hocr.find("bbox 70 22 130 42; x_wconf 88\">World</span>"), std::string::npos);
+    EXPECT_NE(hocr.find(">a&lt;b&amp;c</span>"), std::string::npos);
+    EXPECT_EQ(hocr.find("a<b"), std::string::npos);
+}
+
+TEST(RenderTest, AltoHasStringsAndSpaces) {
+    auto words = sampleWords();
+    auto alto  = render([&](llvm::raw_ostream &os) { imgstr::writeALTO(os, words, "scan.png"); });
+
+    EXPECT_NE(alto.find("<Page WIDTH=\"400\" HEIGHT=\"200\""), std::string::npos);
+    EXPECT_NE(alto.find("<SP WIDTH=\"10\" VPOS=\"20\" HPOS=\"60\"/>"), std::string::npos);
+    EXPECT_NE(alto.find("HPOS=\"70\" VPOS=\"22\" WIDTH=\"60\" HEIGHT=\"20\" WC=\"0.88\" "
+                        "CONTENT=\"World\""),
+              std::string::npos);
+    EXPECT_NE(alto.find("CONTENT=\"a&lt;b&amp;c\""), std::string::npos);
+    EXPECT_NE(alto.find("<TextBlock ID=\"block_1\""), std::string::npos);
+}
+
+TEST(RenderTest, EmptyPageIsWellFormed) {
+    imgstr::OcrWords empty;
+    auto hocr = render([&](llvm::raw_ostream &os) { imgstr::writeHOCR(os, empty, "blank.png"); });
+    auto tsv  = render([&](llvm::raw_ostream &os) { imgstr::writeTSV(os, empty); });
+
+    EXPECT_NE(hocr.find("</html>"), std::string::npos);
+    EXPECT_EQ(std::count(tsv.begin(), tsv.end(), '\n'), 2);
+}
+
+TEST(RenderTest, PlainTextIsRejectedBeforeTheFileIsOpened) {
+    auto path = (std::filesystem::temp_directory_path() / "render_test_plain.txt").string();
+    std::ofstream(path) << "existing";
+
+    auto err = imgstr::writeOcrFile(path, imgstr::OutputFormat::text, sampleWords(), "page.png");
+    EXPECT_TRUE(static_cast<bool>(err));
+    llvm::consumeError(std::move(err));
+
+    std::ifstream     in(path);
+    std::stringstream content;
+    content << in.rdbuf();
+    EXPECT_EQ(content.str(), "existing");
+
+    std::filesystem::remove(path);
+}
+
+auto main(int argc, char **argv) -> int {
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
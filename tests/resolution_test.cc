@@ -0,0 +1,71 @@
+#include <gtest/gtest.h>
+#include <resolution.h>
+
+namespace resolution_test_constants {
+    /// @brief 1 bpp Page with a Grid of square "Letters" of the given Size
+    auto pageWithLetters(l_int32 width, l_int32 height, l_int32 letter) -> PixPtr {
+        PixPtr page(pixCreate(width, height, 1));
+        for (l_int32 top = letter; top + letter < height; top += 3 * letter) {
+            for (l_int32 left = letter; left + letter < width; left += 2 * letter) {
+                for (l_int32 y = top; y < top + letter; ++y) {
+                    for (l_int32 x = left; x < left + letter; ++x) {
+                        pixSetPixel(page.get(), x, y, 1);
+                    }
+                }
+            }
+        }
+        return page;
+    }
+
+    /// @brief 8 bpp Page of dark "Letters" on a shaded Background darker than mid Gray
+    auto shadedPageWithLetters(l_int32 width, l_int32 height, l_int32 letter) -> PixPtr {
+        auto   mask = pageWithLetters(width, height, letter);
+        PixPtr page(pixCreate(width, height, 8));
+        pixSetAllArbitrary(page.get(), 90);
+
+        for (l_int32 y = 0; y < height; ++y) {
+            for (l_int32 x = 0; x < width; ++x) {
+                l_uint32 ink = 0;
+                pixGetPixel(mask.get(), x, y, &ink);
+                if (ink != 0) {
+                    pixSetPixel(page.get(), x, y, 20);
+                }
+            }
+        }
+        return page;
+    }
+} // namespace resolution_test_constants
+
+using namespace resolution_test_constants;
+
+TEST(ResolutionTest, EstimatesXHeightFromLetterComponents) {
+    auto page = pageWithLetters(1200, 1200, 60);
+
+    EXPECT_EQ(imgstr::estimateXHeight(page.get()), 60);
+}
+
+TEST(ResolutionTest, EstimatesXHeightOnDarkBackground) {
+    auto page = shadedPageWithLetters(1200, 1200, 60);
+
+    EXPECT_EQ(imgstr::estimateXHeight(page.get()), 60);
+}
+
+TEST(ResolutionTest, DownscalesLargeTextToTarget) {
+    auto page   = pageWithLetters(1200, 1200, 60);
+    auto scaled = imgstr::normalizeResolution(page.get(), {.target_x_height = 30});
+
+    ASSERT_NE(scaled, nullptr);
+    EXPECT_EQ(pixGetWidth(scaled.get()), 600);
+    EXPECT_EQ(pixGetHeight(scaled.get()), 600);
+}
+
+TEST(ResolutionTest, LeavesSmallTextUnchanged) {
+    auto page = pageWithLetters(600, 600, 20);
+
+    EXPECT_EQ(imgstr::normalizeResolution(page.get(), {.target_x_height = 24}), nullptr);
+}
+
+auto main(int argc, char **argv) -> int {
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,53 @@
+#include <gtest/gtest.h>
+#include <segment.h>
+#include <vector>
+
+namespace segment_test_constants {
+    using Rows = std::vector<std::pair<l_int32, l_int32>>;
+
+    /// @brief 1 bpp Page with full width Lines of ink at the given Row ranges
+    auto pageWithLines(l_int32 width, l_int32 height, const Rows &lines) -> PixPtr {
+        PixPtr page(pixCreate(width, height, 1));
+        for (auto [top, bottom]: lines) {
+            for (l_int32 y = top; y < bottom; ++y) {
+                for (l_int32 x = 0; x < width; ++x) {
+                    pixSetPixel(page.get(), x, y, 1);
+                }
+            }
+        }
+        return page;
+    }
+} // namespace segment_test_constants
+
+using namespace segment_test_constants;
+
+TEST(StripSegmentationTest, CutsFallInWhitespaceGaps) {
+    Rows lines = {{10, 40}, {110, 140}, {210, 240}, {310, 340}};
+
+    auto page = pageWithLines(200, 400, lines);
+    auto cuts = imgstr::findStripCuts(page.get(), 4);
+
+    ASSERT_EQ(cuts.size(), 5);
+    EXPECT_EQ(cuts.front(), 0);
+    EXPECT_EQ(cuts.back(), 400);
+
+    for (std::size_t i = 1; i + 1 < cuts.size(); ++i) {
+        EXPECT_GT(cuts[i], cuts[i - 1]);
+        for (auto [top, bottom]: lines) {
+            EXPECT_FALSE(cuts[i] >= top && cuts[i] < bottom)
+                << "cut " << cuts[i] << " splits a line";
+        }
+    }
+}
+
+TEST(StripSegmentationTest, PageWithoutGapsIsNotSplit) {
+    auto page = pageWithLines(100, 300, {{0, 300}});
+    auto cuts = imgstr::findStripCuts(page.get(), 4);
+
+    EXPECT_EQ(cuts, (std::vector<l_int32> {0, 300}));
+}
+
+auto main(int argc, char **argv) -> int {
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,144 @@
+#include <fcntl.h>
+#include <fs.h>
+#include <gtest/gtest.h>
+#include <shmcache.h>
+#include <string>
+#include <thread>
+#include <unistd.h>
+#include <util.h>
+#include <vector>
+
+namespace shmcache_test_constants {
+    static constexpr auto shmFile = "shmcache_test.shm";
+
+    auto digestOf(uint8_t fill) -> Sha256Digest {
+        Sha256Digest digest;
+        digest.bytes.fill(fill);
+        return digest;
+    }
+} // namespace shmcache_test_constants
+
+using namespace shmcache_test_constants;
+
+class SharedMemoryCacheTests: public ::testing::Test {
+  protected:
+    void SetUp() override { (void) deleteFile(shmFile); }
+
+    void TearDown() override {
+        if (deleteFile(shmFile)) {
+            FAIL() << "Failed to Cleanup Shared Cache File\n";
+        }
+    }
+
+    static auto openCache(uint64_t slots = 64, uint64_t arena = 4096)
+        -> std::unique_ptr<imgstr::SharedMemoryCache> {
+        auto shmOrErr = imgstr::SharedMemoryCache::open(shmFile, slots, arena);
+        if (!shmOrErr) {
+            ADD_FAILURE() << llvm::toString(shmOrErr.takeError());
+            return nullptr;
+        }
+        return std::move(shmOrErr.get());
+    }
+};
+
+TEST_F(SharedMemoryCacheTests, InsertThenLookup) {
+    auto shm = openCache();
+    ASSERT_NE(shm, nullptr);
+
+    EXPECT_TRUE(shm->insert(digestOf(1), "hello"));
+    EXPECT_TRUE(shm->insert(digestOf(1), "hello"));
+
+    EXPECT_EQ(shm->lookup(digestOf(1)), "hello");
+    EXPECT_FALSE(shm->lookup(digestOf(2)).has_value());
+    EXPECT_EQ(shm->size(), 1);
+}
+
+TEST_F(SharedMemoryCacheTests, SecondMappingSeesEntries) {
+    auto writer = openCache();
+    auto reader = openCache(8, 16);
+    ASSERT_NE(writer, nullptr);
+    ASSERT_NE(reader, nullptr);
+
+    ASSERT_TRUE(writer->insert(digestOf(3), "shared"));
+
+    EXPECT_EQ(reader->lookup(digestOf(3)), "shared");
+    EXPECT_EQ(reader->capacity(), 64);
+}
+
+TEST_F(SharedMemoryCacheTests, RejectsInsertsWhenArenaIsFull) {
+    auto shm = openCache(64, 8);
+    ASSERT_NE(shm, nullptr);
+
+    EXPECT_TRUE(shm->insert(digestOf(4), "12345"));
+    EXPECT_FALSE(shm->insert(digestOf(5), "678910"));
+    EXPECT_FALSE(shm->lookup(digestOf(5)).has_value());
+    EXPECT_EQ(shm->lookup(digestOf(4)), "12345");
+}
+
+TEST_F(SharedMemoryCacheTests, FullArenaLeavesSlotsEmpty) {
+    auto shm = openCache(4, 8);
+    ASSERT_NE(shm, nullptr);
+
+    ASSERT_TRUE(shm->insert(digestOf(6), "12345"));
+    for (uint8_t i = 10; i < 40; ++i) {
+        EXPECT_FALSE(shm->insert(digestOf(i), "678910"));
+    }
+
+    // rejected Inserts claimed no Slot - misses still end at a kEmpty Slot and an Entry that
+    // fits is still accepted
+    EXPECT_FALSE(shm->lookup(digestOf(10)).has_value());
+    EXPECT_TRUE(shm->insert(digestOf(7), "678"));
+    EXPECT_TRUE(shm->insert(digestOf(8), ""));
+    EXPECT_EQ(shm->lookup(digestOf(7)), "678");
+    EXPECT_EQ(shm->lookup(digestOf(8)), "");
+    EXPECT_EQ(shm->size(), 3);
+}
+
+TEST_F(SharedMemoryCacheTests, CorruptSlotIsAMiss) {
+    {
+        auto shm = openCache(2, 8);
+        ASSERT_NE(shm, nullptr);
+        ASSERT_TRUE(shm->insert(digestOf(11), "1234"));
+    }
+
+    // Slots follow the 64 Byte Header - point every text_offset (Bytes 8-15 of a Slot) far past
+    // the Arena
+    int fd = ::open(shmFile, O_RDWR);
+    ASSERT_GE(fd, 0);
+    uint64_t offset = uint64_t {1} << 40;
+    for (int slot = 0; slot < 2; ++slot) {
+        ASSERT_EQ(::pwrite(fd, &offset, sizeof(offset), 64 + slot * 48 + 8), sizeof(offset));
+    }
+    ::close(fd);
+
+    auto shm = openCache(2, 8);
+    ASSERT_NE(shm, nullptr);
+    EXPECT_FALSE(shm->lookup(digestOf(11)).has_value());
+}
+
+TEST_F(SharedMemoryCacheTests, ConcurrentInsertAndLookup) {
+    auto shm = openCache(1024, 1 << 16);
+    ASSERT_NE(shm, nullptr);
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&shm] {
+            for (uint8_t i = 0; i < 200; ++i) {
+                shm->insert(digestOf(i), std::to_string(i));
+                auto text = shm->lookup(digestOf(i));
+                ASSERT_TRUE(text.has_value());
+                EXPECT_EQ(*text, std::to_string(i));
+            }
+        });
+    }
+    for (auto &thread: threads) {
+        thread.join();
+    }
+
+    EXPECT_EQ(shm->size(), 200);
+}
+
+auto main(int argc, char **argv) -> int {
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,133 @@
+#include <fcntl.h>
+#include <fs.h>
+#include <gtest/gtest.h>
+#include <llvm/Support/FileSystem.h>
+#include <snapshot.h>
+#include <string>
+#include <unistd.h>
+#include <util.h>
+
+namespace snapshot_test_constants {
+    static constexpr auto snapshotFile = "snapshot_test.snap";
+
+    auto digestOf(uint8_t fill) -> Sha256Digest {
+        Sha256Digest digest;
+        digest.bytes.fill(fill);
+        return digest;
+    }
+} // namespace snapshot_test_constants
+
+using namespace snapshot_test_constants;
+
+class CacheSnapshotTests: public ::testing::Test {
+  protected:
+    void SetUp() override { (void) deleteFile(snapshotFile); }
+
+    void TearDown() override {
+        if (deleteFile(snapshotFile)) {
+            FAIL() << "Failed to Cleanup Snapshot File\n";
+        }
+    }
+};
+
+TEST_F(CacheSnapshotTests, RoundTripPreservesEntries) {
+    std::vector<imgstr::SnapshotEntry> entries(2);
+    entries[0] = {digestOf(1), "a.png", "hello", "2024-01-01", "", "a.txt", "2024-01-02", 5, 42};
+    entries[0].output_written = true;
+    entries[1] = {digestOf(2), "b.png", "packed", "2024-01-03", "ff:1.0", "", "", 300, 7};
+    entries[1].text_compressed = true;
+    entries[1].skipped         = true;
+    entries[1].profile         = OcrProfile::fast;
+
+    ASSERT_TRUE(HandleError<StdErr>(imgstr::writeSnapshot(snapshotFile, entries)));
+
+    auto loadedOrErr = imgstr::readSnapshot(snapshotFile);
+    ASSERT_TRUE(static_cast<bool>(loadedOrErr)) << llvm::toString(loadedOrErr.takeError());
+    ASSERT_EQ(loadedOrErr->size(), 2);
+
+    const auto &first = (*loadedOrErr)[0];
+    EXPECT_EQ(first.hash, digestOf(1));
+    EXPECT_EQ(first.uri, "a.png");
+    EXPECT_EQ(first.text, "hello");
+    EXPECT_EQ(first.output_path, "a.txt");
+    EXPECT_EQ(first.image_size, 42);
+    EXPECT_TRUE(first.output_written);
+    EXPECT_FALSE(first.text_compressed);
+    EXPECT_FALSE(first.skipped);
+
+    const auto &second = (*loadedOrErr)[1];
+    EXPECT_EQ(second.fuzzhash, "ff:1.0");
+    EXPECT_EQ(second.text_size, 300);
+    EXPECT_TRUE(second.text_compressed);
+    EXPECT_TRUE(second.skipped);
+    EXPECT_EQ(second.profile, OcrProfile::fast);
+    EXPECT_EQ(first.profile, OcrProfile::balanced);
+}
+
+TEST_F(CacheSnapshotTests, TruncatedSnapshotIsRejected) {
+    std::vector<imgstr::SnapshotEntry> entries(1);
+    entries[0] = {digestOf(3), "c.png", "text", "", "", "", "", 4, 1};
+
+    ASSERT_TRUE(HandleError<StdErr>(imgstr::writeSnapshot(snapshotFile, entries)));
+
+    uint64_t size = 0;
+    ASSERT_FALSE(llvm::sys::fs::file_size(snapshotFile, size));
+    ASSERT_EQ(::truncate(snapshotFile, static_cast<off_t>(size - 2)), 0);
+
+    auto loadedOrErr = imgstr::readSnapshot(snapshotFile);
+    EXPECT_FALSE(static_cast<bool>(loadedOrErr));
+    llvm::consumeError(loadedOrErr.takeError());
+}
+
+TEST_F(CacheSnapshotTests, OversizedEntryCountIsRejected) {
+    std::vector<imgstr::SnapshotEntry> entries(1);
+    entries[0] = {digestOf(4), "d.png", "text", "", "", "", "", 4, 1};
+
+    ASSERT_TRUE(HandleError<StdErr>(imgstr::writeSnapshot(snapshotFile, entries)));
+
+    // entry_count follows magic, version and checksum - the checksum only covers the body
+    uint64_t entry_count = uint64_t {1} << 60;
+    int      fd          = ::open(snapshotFile, O_WRONLY);
+    ASSERT_GE(fd, 0);
+    ASSERT_EQ(::pwrite(fd, &entry_count, sizeof(entry_count), 16), sizeof(entry_count));
+    ::close(fd);
+
+    auto loadedOrErr = imgstr::readSnapshot(snapshotFile);
+    EXPECT_FALSE(static_cast<bool>(loadedOrErr));
+    llvm::consumeError(loadedOrErr.takeError());
+}
+
+TEST_F(CacheSnapshotTests, UnknownLanguageIsRejected) {
+    std::vector<imgstr::SnapshotEntry> entries(1);
+    entries[0]      = {digestOf(5), "e.png", "text", "", "", "", "", 4, 1};
+    entries[0].lang = static_cast<ISOLang>(200);
+
+    ASSERT_TRUE(HandleError<StdErr>(imgstr::writeSnapshot(snapshotFile, entries)));
+
+    auto loadedOrErr = imgstr::readSnapshot(snapshotFile);
+    EXPECT_FALSE(static_cast<bool>(loadedOrErr));
+    llvm::consumeError(loadedOrErr.takeError());
+}
+
+TEST_F(CacheSnapshotTests, OlderVersionIsRejected) {
+    std::vector<imgstr::SnapshotEntry> entries(1);
+    entries[0] = {digestOf(6), "f.png", "text", "", "", "", "", 4, 1};
+
+    ASSERT_TRUE(HandleError<StdErr>(imgstr::writeSnapshot(snapshotFile, entries)));
+
+    // version follows the 8 Byte magic
+    uint32_t version = 1;
+    int      fd      = ::open(snapshotFile, O_WRONLY);
+    ASSERT_GE(fd, 0);
+    ASSERT_EQ(::pwrite(fd, &version, sizeof(version), 8), sizeof(version));
+    ::close(fd);
+
+    auto loadedOrErr = imgstr::readSnapshot(snapshotFile);
+    EXPECT_FALSE(static_cast<bool>(loadedOrErr));
+    llvm::consumeError(loadedOrErr.takeError());
+}
+
+auto main(int argc, char **argv) -> int {
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
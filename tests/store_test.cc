@@ -0,0 +1,116 @@
+#include <fs.h>
+#include <gtest/gtest.h>
+#include <llvm/Support/FileSystem.h>
+#include <store.h>
+#include <string>
+#include <unistd.h>
+#include <util.h>
+
+namespace store_test_constants {
+    static constexpr auto storeFile = "store_test.kimg";
+
+    auto digestOf(uint8_t fill) -> Sha256Digest {
+        Sha256Digest digest;
+        digest.bytes.fill(fill);
+        return digest;
+    }
+} // namespace store_test_constants
+
+using namespace store_test_constants;
+
+class ImageStoreTests: public ::testing::Test {
+  protected:
+    void SetUp() override { (void) deleteFile(storeFile); }
+
+    void TearDown() override {
+        if (deleteFile(storeFile)) {
+            FAIL() << "Failed to Cleanup Store File\n";
+        }
+    }
+
+    static auto openStore() -> std::unique_ptr<imgstr::ImageStore> {
+        auto storeOrErr = imgstr::ImageStore::open(storeFile);
+        if (!storeOrErr) {
+            ADD_FAILURE() << llvm::toString(storeOrErr.takeError());
+            return nullptr;
+        }
+        return std::move(storeOrErr.get());
+    }
+};
+
+TEST_F(ImageStoreTests, AppendThenLookup) {
+    auto store = openStore();
+    ASSERT_NE(store, nullptr);
+
+    ASSERT_TRUE(HandleError<StdErr>(store->append({digestOf(1), "/img/a.png", "hello", "", 42})));
+
+    auto record = store->lookup(digestOf(1));
+    ASSERT_TRUE(record.has_value());
+    EXPECT_EQ(record->uri, "/img/a.png");
+    EXPECT_EQ(record->text, "hello");
+    EXPECT_EQ(record->image_size, 42);
+    EXPECT_FALSE(store->lookup(digestOf(2)).has_value());
+}
+
+TEST_F(ImageStoreTests, RecordsSurviveReopen) {
+    {
+        auto store = openStore();
+        ASSERT_NE(store, nullptr);
+        ASSERT_TRUE(HandleError<StdErr>(store->append({digestOf(3), "a.png", "first", "", 1})));
+        ASSERT_TRUE(HandleError<StdErr>(store->append({digestOf(4), "b.png", "second", "", 2})));
+    }
+
+    auto store = openStore();
+    ASSERT_NE(store, nullptr);
+    EXPECT_EQ(store->size(), 2);
+    EXPECT_EQ(store->lookup(digestOf(3))->text, "first");
+    EXPECT_EQ(store->lookup(digestOf(4))->text, "second");
+}
+
+TEST_F(ImageStoreTests, TornTailIsTruncated) {
+    {
+        auto store = openStore();
+        ASSERT_NE(store, nullptr);
+        ASSERT_TRUE(HandleError<StdErr>(store->append({digestOf(5), "a.png", "intact", "", 1})));
+        ASSERT_TRUE(HandleError<StdErr>(store->append({digestOf(6), "b.png", "partial", "", 2})));
+    }
+
+    uint64_t size = 0;
+    ASSERT_FALSE(llvm::sys::fs::file_size(storeFile, size));
+    ASSERT_EQ(::truncate(storeFile, static_cast<off_t>(size - 3)), 0);
+
+    auto store = openStore();
+    ASSERT_NE(store, nullptr);
+    EXPECT_TRUE(store->contains(digestOf(5)));
+    EXPECT_FALSE(store->contains(digestOf(6)));
+
+    ASSERT_TRUE(HandleError<StdErr>(store->append({digestOf(7), "c.png", "after", "", 3})));
+    EXPECT_EQ(store->lookup(digestOf(7))->text, "after");
+}
+
+TEST_F(ImageStoreTests, SecondOpenIsRejected) {
+    auto store = openStore();
+    ASSERT_NE(store, nullptr);
+
+    auto second = imgstr::ImageStore::open(storeFile);
+    ASSERT_FALSE(static_cast<bool>(second));
+    llvm::consumeError(second.takeError());
+
+    store.reset();
+    EXPECT_NE(openStore(), nullptr);
+}
+
+TEST_F(ImageStoreTests, ShortForeignFileIsNotReinitialized) {
+    ASSERT_FALSE(writeStringToFile(storeFile, "not a store"));
+
+    auto store = imgstr::ImageStore::open(storeFile);
+    ASSERT_FALSE(static_cast<bool>(store));
+    llvm::consumeError(store.takeError());
+
+    EXPECT_EQ(readFileToString(storeFile), "not a store");
+}
+
+auto main(int argc, char **argv) -> int {
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
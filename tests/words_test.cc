@@ -0,0 +1,39 @@
+#include <gtest/gtest.h>
+#include <words.h>
+
+TEST(WordResultsTest, WordsAreParallelArrays) {
+    imgstr::OcrWords words;
+    words.push("Hello", {10, 20, 60, 40}, 95.0F, 0, 0);
+    words.push("World", {70, 20, 130, 40}, 88.5F, 0, 0);
+    words.push("Über", {10, 60, 50, 80}, 72.0F, 1, 1);
+
+    ASSERT_EQ(words.size(), 3);
+    EXPECT_EQ(words.word(0), "Hello");
+    EXPECT_EQ(words.word(1), "World");
+    EXPECT_EQ(words.word(2), "Über");
+    EXPECT_EQ(words.chars, "HelloWorldÜber");
+
+    EXPECT_EQ(words.boxes[1].left, 70);
+    EXPECT_FLOAT_EQ(words.confidences[1], 88.5F);
+    EXPECT_EQ(words.line_ids[1], 0);
+    EXPECT_EQ(words.line_ids[2], 1);
+    EXPECT_EQ(words.block_ids[2], 1);
+    EXPECT_GT(words.footprint(), words.chars.size());
+}
+
+TEST(WordResultsTest, ScaleMapsBoxesToOriginalPixels) {
+    imgstr::OcrWords words;
+    words.push("scaled", {10, 20, 30, 40}, 90.0F, 0, 0);
+
+    words.scale(2.0F, 0.5F);
+
+    EXPECT_EQ(words.boxes[0].left, 20);
+    EXPECT_EQ(words.boxes[0].top, 10);
+    EXPECT_EQ(words.boxes[0].right, 60);
+    EXPECT_EQ(words.boxes[0].bottom, 20);
+}
+
+auto main(int argc, char **argv) -> int {
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}